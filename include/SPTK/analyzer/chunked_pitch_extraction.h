@@ -0,0 +1,171 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_ANALYZER_CHUNKED_PITCH_EXTRACTION_H_
+#define SPTK_ANALYZER_CHUNKED_PITCH_EXTRACTION_H_
+
+#include <functional>  // std::function
+#include <istream>     // std::istream
+#include <vector>      // std::vector
+
+#include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+// Extract pitch from a long waveform chunk by chunk. Each chunk is extended
+// by context on both sides before the extraction, and only the frames of the
+// chunk itself are kept, so the tracks are continuous across the boundaries.
+// Several chunks are processed in parallel, and the memory usage depends only
+// on the chunk length and the number of threads. The dither of RAPT is added
+// to the whole input in order, so RAPT gives the same result as the single
+// pass. WORLD removes the mean of its input before the analysis, so its result
+// may slightly differ. REAPER is not supported because it decides the polarity
+// and the voicing scale from the whole input.
+class ChunkedPitchExtraction {
+ public:
+  // Write f0 of the frames in a chunk. This is called in the order of chunks.
+  typedef std::function<bool(const std::vector<double>& f0)> F0Writer;
+
+  // Write the epochs [sec] in a chunk. This is called in the order of chunks.
+  typedef std::function<bool(const std::vector<double>& epochs)> EpochWriter;
+
+  //
+  ChunkedPitchExtraction(int frame_shift, double sampling_rate,
+                         double minimum_f0, double maximum_f0,
+                         double voicing_threshold,
+                         PitchExtraction::Algorithms algorithm,
+                         int chunk_length, int num_thread);
+
+  //
+  virtual ~ChunkedPitchExtraction() {
+  }
+
+  // Return the number of frames [frame] attached to both sides of a chunk so
+  // that the f0 of the chunk does not depend on where the chunk is cut.
+  static int CalculateContextLength(int frame_shift, double sampling_rate,
+                                    double minimum_f0,
+                                    PitchExtraction::Algorithms algorithm);
+
+  // Return the number of frames to which the beginning of a waveform given to
+  // the extractor must be aligned.
+  static int CalculateAlignment(int frame_shift, double sampling_rate,
+                                double minimum_f0,
+                                PitchExtraction::Algorithms algorithm);
+
+  //
+  int GetFrameShift() const {
+    return frame_shift_;
+  }
+
+  //
+  int GetChunkLength() const {
+    return chunk_length_;
+  }
+
+  //
+  int GetContextLength() const {
+    return context_length_;
+  }
+
+  //
+  int GetAlignment() const {
+    return alignment_;
+  }
+
+  //
+  int GetNumThread() const {
+    return num_thread_;
+  }
+
+  //
+  PitchExtraction::Algorithms GetAlgorithm() const {
+    return algorithm_;
+  }
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  // Extract pitch from the whole input stream. An empty writer means that the
+  // corresponding result is not required.
+  bool Run(const F0Writer& f0_writer, const EpochWriter& epoch_writer,
+           std::istream* input_stream) const;
+
+ private:
+  //
+  const int frame_shift_;
+
+  //
+  const double sampling_rate_;
+
+  //
+  const int chunk_length_;
+
+  //
+  const int num_thread_;
+
+  //
+  const PitchExtraction::Algorithms algorithm_;
+
+  //
+  const PitchExtraction pitch_extraction_;
+
+  //
+  int context_length_;
+
+  //
+  int alignment_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(ChunkedPitchExtraction);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_ANALYZER_CHUNKED_PITCH_EXTRACTION_H_
@@ -62,6 +62,13 @@ class PitchExtraction {
                   double maximum_f0, double voicing_threshold,
                   Algorithms algorithm);
 
+  // If dithered_input_flag is true, RAPT assumes that the input waveform has
+  // been dithered by PitchExtractionByRapt::Dither(). The flag is ignored by
+  // the other algorithms.
+  PitchExtraction(int frame_shift, double sampling_rate, double minimum_f0,
+                  double maximum_f0, double voicing_threshold,
+                  Algorithms algorithm, bool dithered_input_flag);
+
   //
   virtual ~PitchExtraction() {
     delete pitch_extractor_;
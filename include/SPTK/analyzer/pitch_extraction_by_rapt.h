@@ -48,17 +48,40 @@
 #include <vector>  // std::vector
 
 #include "SPTK/analyzer/pitch_extraction_interface.h"
+#include "SPTK/generator/normal_distributed_random_value_generation.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
 
 class PitchExtractionByRapt : public PitchExtractionInterface {
  public:
+  // Buffer for dithering a waveform piece by piece.
+  class Buffer {
+   public:
+    // The noise sequence is the same for every waveform.
+    Buffer() : generator_(1) {
+    }
+
+    virtual ~Buffer() {
+    }
+
+   private:
+    NormalDistributedRandomValueGeneration generator_;
+    friend class PitchExtractionByRapt;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
   //
   PitchExtractionByRapt(int frame_shift, double sampling_rate,
                         double minimum_f0, double maximum_f0,
                         double voicing_threshold);
 
+  // If dithered_input_flag is true, the input waveform of Get() must have
+  // been dithered by Dither() in advance.
+  PitchExtractionByRapt(int frame_shift, double sampling_rate,
+                        double minimum_f0, double maximum_f0,
+                        double voicing_threshold, bool dithered_input_flag);
+
   //
   virtual ~PitchExtractionByRapt() {
   }
@@ -88,11 +111,22 @@ class PitchExtractionByRapt : public PitchExtractionInterface {
     return voicing_threshold_;
   }
 
+  //
+  bool GetDitheredInputFlag() const {
+    return dithered_input_flag_;
+  }
+
   //
   virtual bool IsValid() const {
     return is_valid_;
   }
 
+  // Add the noise that stabilizes the analysis to the samples. The pieces of
+  // a waveform dithered in order with one buffer get the same noise as the
+  // whole waveform, so the noise of a sample depends only on its position.
+  static bool Dither(int num_sample, double* waveform,
+                     PitchExtractionByRapt::Buffer* buffer);
+
   //
   virtual bool Get(const std::vector<double>& waveform, std::vector<double>* f0,
                    std::vector<double>* epochs,
@@ -114,6 +148,9 @@ class PitchExtractionByRapt : public PitchExtractionInterface {
   //
   const double voicing_threshold_;
 
+  //
+  const bool dithered_input_flag_;
+
   //
   bool is_valid_;
 
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
+#define SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
+
+#include <vector>  // std::vector
+
+#include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+namespace swipe {
+class StreamingSwipe;
+class StreamingSwipeBuffer;
+}  // namespace swipe
+
+// Extract pitch from a waveform given piece by piece. Only SWIPE' is
+// supported. The loudness of each analysis window is computed once, and the
+// f0 of a frame is output as soon as all the windows it is interpolated from
+// are pushed, so the output is identical to that of PitchExtraction. The
+// other algorithms normalize, track or dither over the whole waveform and are
+// not supported.
+class StreamingPitchExtraction {
+ public:
+  class Buffer {
+   public:
+    Buffer();
+
+    virtual ~Buffer();
+
+   private:
+    //
+    swipe::StreamingSwipeBuffer* swipe_buffer_;
+    // The number of samples pushed.
+    int num_sample_;
+    // The number of frames output.
+    int num_frame_;
+    // The f0 of the last frame output.
+    double last_f0_;
+    friend class StreamingPitchExtraction;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  //
+  StreamingPitchExtraction(int frame_shift, double sampling_rate,
+                           double minimum_f0, double maximum_f0,
+                           double voicing_threshold,
+                           PitchExtraction::Algorithms algorithm);
+
+  //
+  virtual ~StreamingPitchExtraction();
+
+  //
+  int GetFrameShift() const {
+    return frame_shift_;
+  }
+
+  // Return the number of samples to be pushed after the first sample of a
+  // frame before the f0 of the frame is pulled. It is the longest window of
+  // SWIPE', e.g., 2048 for 16 kHz sampling and a minimum f0 of 60 Hz.
+  int GetLatency() const;
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  // Append waveform to the buffer.
+  bool Push(const std::vector<double>& waveform, Buffer* buffer) const;
+
+  // Output f0 of all the frames whose windows are pushed. The output may be
+  // empty.
+  bool Pull(std::vector<double>* f0, Buffer* buffer) const;
+
+  // Output f0 of all the remaining frames at the end of the waveform, and
+  // make the buffer ready for the next waveform.
+  bool Flush(std::vector<double>* f0, Buffer* buffer) const;
+
+ private:
+  //
+  const int frame_shift_;
+
+  //
+  swipe::StreamingSwipe* swipe_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(StreamingPitchExtraction);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_ANALYZER_STREAMING_PITCH_EXTRACTION_H_
@@ -45,6 +45,7 @@
 #ifndef SPTK_CONVERTER_MEL_GENERALIZED_CEPSTRUM_TO_MEL_GENERALIZED_CEPSTRUM_H_
 #define SPTK_CONVERTER_MEL_GENERALIZED_CEPSTRUM_TO_MEL_GENERALIZED_CEPSTRUM_H_
 
+#include <string>  // std::string
 #include <vector>  // std::vector
 
 #include "SPTK/math/frequency_transform.h"
@@ -78,7 +79,9 @@ class MelGeneralizedCepstrumToMelGeneralizedCepstrum {
         FrequencyTransform::Buffer* frequency_transform_buffer) const = 0;
   };
 
-  //
+  // The conversion is planned here as a chain of modules. Consecutive linear
+  // steps are fused into one matrix, and gain normalizations undone by the
+  // following step are removed.
   MelGeneralizedCepstrumToMelGeneralizedCepstrum(
       int num_input_order_, double input_alpha_, double input_gamma_,
       bool is_normalized_input_, bool is_multiplied_input_,
@@ -149,6 +152,11 @@ class MelGeneralizedCepstrumToMelGeneralizedCepstrum {
     return is_valid_;
   }
 
+  // Get the description of each module in the order of execution.
+  const std::vector<std::string>& GetPlan() const {
+    return plan_;
+  }
+
   //
   bool Run(
       const std::vector<double>& input, std::vector<double>* output,
@@ -192,6 +200,9 @@ class MelGeneralizedCepstrumToMelGeneralizedCepstrum {
   std::vector<MelGeneralizedCepstrumToMelGeneralizedCepstrum::ModuleInterface*>
       modules_;
 
+  //
+  std::vector<std::string> plan_;
+
   //
   bool is_valid_;
 
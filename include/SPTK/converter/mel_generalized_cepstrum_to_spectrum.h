@@ -115,7 +115,7 @@ class MelGeneralizedCepstrumToSpectrum {
     return is_valid_;
   }
 
-  //
+  // The output spectra contain the first fft_length / 2 + 1 bins only.
   bool Run(const std::vector<double>& mel_generalized_cepstrum,
            std::vector<double>* amplitude_spectrum,
            std::vector<double>* phase_spectrum,
@@ -64,6 +64,8 @@ class InverseMglsaDigitalFilter {
    private:
     std::vector<double> signals_;
     std::vector<double> inverse_filter_coefficients_;
+    std::vector<double> inverse_increments_of_filter_coefficients_;
+    std::vector<double> interpolated_filter_coefficients_;
     MlsaDigitalFilter::Buffer mlsa_digital_filter_buffer_;
     friend class InverseMglsaDigitalFilter;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
@@ -112,7 +114,32 @@ class InverseMglsaDigitalFilter {
            double* filter_output,
            InverseMglsaDigitalFilter::Buffer* buffer) const;
 
+  // Filter num_samples samples with fixed filter coefficients.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples,
+                InverseMglsaDigitalFilter::Buffer* buffer) const;
+
+  // Filter num_samples samples while adding the increments to the filter
+  // coefficients after each sample.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const std::vector<double>& increments_of_filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples,
+                InverseMglsaDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void Negate(const std::vector<double>& input,
+              std::vector<double>* output) const;
+
+  //
+  void PrepareBuffer(InverseMglsaDigitalFilter::Buffer* buffer) const;
+
+  //
+  double RunSample(const double* b, double gained_input,
+                   InverseMglsaDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
@@ -63,6 +63,7 @@ class MglsaDigitalFilter {
 
    private:
     std::vector<double> signals_;
+    std::vector<double> interpolated_filter_coefficients_;
     MlsaDigitalFilter::Buffer mlsa_digital_filter_buffer_;
     friend class MglsaDigitalFilter;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
@@ -110,7 +111,26 @@ class MglsaDigitalFilter {
   bool Run(const std::vector<double>& filter_coefficients, double filter_input,
            double* filter_output, MglsaDigitalFilter::Buffer* buffer) const;
 
+  // Filter num_samples samples with fixed filter coefficients.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples, MglsaDigitalFilter::Buffer* buffer) const;
+
+  // Filter num_samples samples while adding the increments to the filter
+  // coefficients after each sample.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const std::vector<double>& increments_of_filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples, MglsaDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(MglsaDigitalFilter::Buffer* buffer) const;
+
+  //
+  double RunSample(const double* b, double gained_input,
+                   MglsaDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
@@ -65,6 +65,7 @@ class MlsaDigitalFilter {
     std::vector<double> signals_for_basic_filter2_;
     std::vector<double> signals_for_exp_filter1_;
     std::vector<double> signals_for_exp_filter2_;
+    std::vector<double> interpolated_filter_coefficients_;
     friend class MlsaDigitalFilter;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -106,7 +107,26 @@ class MlsaDigitalFilter {
   bool Run(const std::vector<double>& filter_coefficients, double filter_input,
            double* filter_output, MlsaDigitalFilter::Buffer* buffer) const;
 
+  // Filter num_samples samples with fixed filter coefficients.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples, MlsaDigitalFilter::Buffer* buffer) const;
+
+  // Filter num_samples samples while adding the increments to the filter
+  // coefficients after each sample.
+  bool RunBlock(const std::vector<double>& filter_coefficients,
+                const std::vector<double>& increments_of_filter_coefficients,
+                const double* filter_input, double* filter_output,
+                int num_samples, MlsaDigitalFilter::Buffer* buffer) const;
+
  private:
+  //
+  void PrepareBuffer(MlsaDigitalFilter::Buffer* buffer) const;
+
+  //
+  double RunSample(const double* b, double gained_input,
+                   MlsaDigitalFilter::Buffer* buffer) const;
+
   //
   const int num_filter_order_;
 
@@ -0,0 +1,118 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#ifndef SPTK_INPUT_INPUT_SOURCE_FROM_MAPPED_FILE_H_
+#define SPTK_INPUT_INPUT_SOURCE_FROM_MAPPED_FILE_H_
+
+#include <cstddef>  // std::size_t
+#include <vector>   // std::vector
+
+#include "SPTK/input/input_source_interface.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+class InputSourceFromMappedFile : public InputSourceInterface {
+ public:
+  //
+  InputSourceFromMappedFile(bool zero_padding, int stream_skip, int read_size,
+                            const char* file_name);
+
+  //
+  virtual ~InputSourceFromMappedFile();
+
+  //
+  virtual int GetSize() const {
+    return read_size_;
+  }
+
+  //
+  int GetStreamSkip() const {
+    return stream_skip_;
+  }
+
+  //
+  virtual bool IsValid() const {
+    return is_valid_;
+  }
+
+  //
+  virtual bool Get(std::vector<double>* buffer);
+
+  // Return a pointer to the next frame without copying it. The pointer is
+  // valid until the next call or the destruction of this object.
+  bool Get(const double** frame, int* actual_read_size);
+
+ private:
+  //
+  const bool zero_padding_;
+
+  //
+  const int stream_skip_;
+
+  //
+  const int read_size_;
+
+  //
+  void* mapped_data_;
+
+  //
+  std::size_t mapped_size_;
+
+  //
+  std::size_t position_;
+
+  //
+  std::vector<double> padded_frame_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(InputSourceFromMappedFile);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_INPUT_INPUT_SOURCE_FROM_MAPPED_FILE_H_
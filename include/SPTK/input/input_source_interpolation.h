@@ -91,10 +91,21 @@ class InputSourceInterpolation : public InputSourceInterface {
   //
   virtual bool Get(std::vector<double>* buffer);
 
+  // Get the data of a run of at most max_num_samples samples at once. Over the
+  // run, the data are obtained by adding the increment after each sample; the
+  // increment is zero unless the interpolation period is one. The number of
+  // samples in the run is returned in num_samples.
+  bool Get(int max_num_samples, std::vector<double>* buffer,
+           std::vector<double>* increment, int* num_samples);
+
  private:
   //
   void CalculateIncrement();
 
+  // Update the internal states for the next sample. Return false if the data
+  // of the next sample are not given by adding the increment of Get.
+  bool Update();
+
   //
   const int frame_period_;
 
@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+#ifndef SPTK_MATH_CHOLESKY_DECOMPOSITION_H_
+#define SPTK_MATH_CHOLESKY_DECOMPOSITION_H_
+
+#include <vector>  // std::vector
+
+#include "SPTK/math/symmetric_matrix.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+// Decompose a symmetric matrix A into L D L^T, where L is a unit lower
+// triangular matrix and D is a diagonal matrix. The decomposition is kept in
+// the buffer, so it can be reused to solve linear equations with many
+// right-hand sides without forming the inverse matrix.
+class CholeskyDecomposition {
+ public:
+  class Buffer {
+   public:
+    Buffer() {
+    }
+    virtual ~Buffer() {
+    }
+
+   private:
+    SymmetricMatrix lower_triangular_matrix_;
+    std::vector<double> inverse_diagonal_elements_;
+    std::vector<double> work_;
+    std::vector<double> interleaved_matrices_;
+    std::vector<double> interleaved_inverse_matrices_;
+    std::vector<double> interleaved_inverse_diagonal_elements_;
+    std::vector<double> interleaved_work_;
+    friend class CholeskyDecomposition;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
+  //
+  explicit CholeskyDecomposition(int num_order);
+
+  //
+  virtual ~CholeskyDecomposition() {
+  }
+
+  //
+  int GetNumOrder() const {
+    return num_order_;
+  }
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  //
+  bool Run(const SymmetricMatrix& matrix,
+           CholeskyDecomposition::Buffer* buffer) const;
+
+  // Solve A x = b using the decomposition computed by Run.
+  bool Solve(const CholeskyDecomposition::Buffer& buffer,
+             const std::vector<double>& constant_vector,
+             std::vector<double>* solution_vector) const;
+
+  // Compute the inverse of A using the decomposition computed by Run.
+  bool Invert(const CholeskyDecomposition::Buffer& buffer,
+              SymmetricMatrix* inverse_matrix) const;
+
+  // Invert many matrices at once. The matrices are processed in interleaved
+  // order so that the innermost loops run across matrices, which is faster
+  // than inverting small matrices one by one.
+  bool Invert(const std::vector<SymmetricMatrix>& matrices,
+              std::vector<SymmetricMatrix>* inverse_matrices,
+              CholeskyDecomposition::Buffer* buffer) const;
+
+ private:
+  //
+  const int num_order_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(CholeskyDecomposition);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_MATH_CHOLESKY_DECOMPOSITION_H_
@@ -45,6 +45,7 @@
 #ifndef SPTK_MATH_DYNAMIC_TIME_WARPING_H_
 #define SPTK_MATH_DYNAMIC_TIME_WARPING_H_
 
+#include <cstddef>  // std::size_t
 #include <utility>  // std::pair
 #include <vector>   // std::vector
 
@@ -67,10 +68,37 @@ class DynamicTimeWarping {
     kNumTypes
   };
 
+  //
+  enum GlobalPathConstraints {
+    kNone = 0,
+    kSakoeChibaBand,
+    kItakuraParallelogram,
+    kNumGlobalPathConstraints
+  };
+
   //
   DynamicTimeWarping(int num_order, LocalPathConstraints local_path_constraint,
                      DistanceCalculator::DistanceMetrics distance_metric);
 
+  // The parameter of the global path constraint is the width of band for
+  // Sakoe-Chiba band and the maximum slope for Itakura parallelogram. All cells
+  // touching the band or the parallelogram are evaluated, so that the first
+  // and last cells can always be left and entered along the axes.
+  DynamicTimeWarping(int num_order, LocalPathConstraints local_path_constraint,
+                     DistanceCalculator::DistanceMetrics distance_metric,
+                     GlobalPathConstraints global_path_constraint,
+                     double global_path_constraint_parameter);
+
+  // If the back pointers of all cells need more bytes than
+  // maximum_memory_size, the Viterbi path is found by divide and conquer,
+  // which takes about twice as long but only needs memory proportional to
+  // the lengths of the vector sequences. Zero means no limit.
+  DynamicTimeWarping(int num_order, LocalPathConstraints local_path_constraint,
+                     DistanceCalculator::DistanceMetrics distance_metric,
+                     GlobalPathConstraints global_path_constraint,
+                     double global_path_constraint_parameter,
+                     std::size_t maximum_memory_size);
+
   //
   virtual ~DynamicTimeWarping() {
   }
@@ -90,27 +118,112 @@ class DynamicTimeWarping {
     return distance_calculator_.GetDistanceMetric();
   }
 
+  //
+  GlobalPathConstraints GetGlobalPathConstraint() const {
+    return global_path_constraint_;
+  }
+
+  //
+  double GetGlobalPathConstraintParameter() const {
+    return global_path_constraint_parameter_;
+  }
+
+  //
+  std::size_t GetMaximumMemorySize() const {
+    return maximum_memory_size_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
   }
 
-  //
+  // If viterbi_path is NULL, only the total score is computed and the memory
+  // usage is proportional to the length of reference vector sequence.
   bool Run(const std::vector<std::vector<double> >& query_vector_sequence,
            const std::vector<std::vector<double> >& reference_vector_sequence,
            std::vector<std::pair<int, int> >* viterbi_path,
            double* total_score) const;
 
  private:
+  //
+  void CalculateRangeOfReference(int num_query_vector,
+                                 int num_reference_vector,
+                                 std::vector<int>* begin,
+                                 std::vector<int>* end) const;
+
+  // Calculate the accumulated scores of rows [begin_i, end_i) in the range
+  // from first_cell to the column last_j. The scores of the latest rows are
+  // kept in the rolling rows, so rows can be added by the next call. The first
+  // cell is regarded as entered by a diagonal move if the flag is true. Back
+  // pointers are stored only if begin_i is the row of the first cell.
+  bool CalculateForwardScores(
+      const std::vector<std::vector<double> >& query_vector_sequence,
+      const std::vector<std::vector<double> >& reference_vector_sequence,
+      const std::vector<int>& begin, const std::vector<int>& end,
+      const std::pair<int, int>& first_cell, int last_j,
+      bool is_first_entered_diagonally, int begin_i, int end_i,
+      std::vector<std::vector<double> >* scores,
+      std::vector<std::vector<double> >* scores_for_skip_transition,
+      std::vector<std::size_t>* offsets,
+      std::vector<signed char>* back_pointers,
+      std::vector<signed char>* back_pointers_for_skip_transition) const;
+
+  // Calculate the scores from the cells to last_cell for the rows from the row
+  // of last_cell down to begin_i. The scores for the cells entered by a skip
+  // transition are stored separately. The last cell must be entered by a
+  // diagonal move if the flag is true.
+  bool CalculateBackwardScores(
+      const std::vector<std::vector<double> >& query_vector_sequence,
+      const std::vector<std::vector<double> >& reference_vector_sequence,
+      const std::vector<int>& begin, const std::vector<int>& end,
+      int first_j, const std::pair<int, int>& last_cell,
+      bool is_last_entered_diagonally, int begin_i,
+      std::vector<std::vector<double> >* scores,
+      std::vector<std::vector<double> >* scores_after_skip_transition,
+      std::vector<std::vector<double> >* local_distances) const;
+
+  // Find the Viterbi path from first_cell to last_cell with back pointers.
+  bool FindViterbiPath(
+      const std::vector<std::vector<double> >& query_vector_sequence,
+      const std::vector<std::vector<double> >& reference_vector_sequence,
+      const std::vector<int>& begin, const std::vector<int>& end,
+      const std::pair<int, int>& first_cell,
+      const std::pair<int, int>& last_cell, bool is_first_entered_diagonally,
+      bool is_last_entered_diagonally,
+      std::vector<std::pair<int, int> >* viterbi_path,
+      double* total_score) const;
+
+  // Find the Viterbi path by splitting it at the middle row recursively. The
+  // total score is also calculated if total_score is not NULL.
+  bool FindViterbiPathByDivideAndConquer(
+      const std::vector<std::vector<double> >& query_vector_sequence,
+      const std::vector<std::vector<double> >& reference_vector_sequence,
+      const std::vector<int>& begin, const std::vector<int>& end,
+      const std::pair<int, int>& first_cell,
+      const std::pair<int, int>& last_cell, bool is_first_entered_diagonally,
+      bool is_last_entered_diagonally,
+      std::vector<std::pair<int, int> >* viterbi_path,
+      double* total_score) const;
+
   //
   const int num_order_;
 
   //
   const LocalPathConstraints local_path_constraint_;
 
+  //
+  const GlobalPathConstraints global_path_constraint_;
+
+  //
+  const double global_path_constraint_parameter_;
+
   //
   const DistanceCalculator distance_calculator_;
 
+  //
+  const std::size_t maximum_memory_size_;
+
   //
   bool is_valid_;
 
@@ -120,6 +233,12 @@ class DynamicTimeWarping {
   //
   std::vector<double> local_path_weights_;
 
+  //
+  int num_rolling_rows_;
+
+  //
+  bool includes_skip_transition_;
+
   //
   DISALLOW_COPY_AND_ASSIGN(DynamicTimeWarping);
 };
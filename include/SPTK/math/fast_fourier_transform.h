@@ -47,17 +47,22 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
 
 class FastFourierTransform {
  public:
+  //
+  enum Algorithms { kMixedRadix = 0, kBluestein };
+
   //
   FastFourierTransform(int num_order, int fft_length);
 
   //
   virtual ~FastFourierTransform() {
+    delete bluestein_fast_fourier_transform_;
   }
 
   //
@@ -70,6 +75,11 @@ class FastFourierTransform {
     return fft_length_;
   }
 
+  //
+  Algorithms GetAlgorithm() const {
+    return algorithm_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -81,7 +91,20 @@ class FastFourierTransform {
            std::vector<double>* real_part_output,
            std::vector<double>* imaginary_part_output) const;
 
+  // Transform each row of the input matrices, i.e., each frame. The twiddle
+  // factors of a stage are shared by all the frames.
+  bool Run(const sptk::Matrix& real_part_input,
+           const sptk::Matrix& imaginary_part_input,
+           sptk::Matrix* real_part_output,
+           sptk::Matrix* imaginary_part_output) const;
+
  private:
+  //
+  void RunMixedRadix(int num_frames, double* x, double* y) const;
+
+  //
+  void RunBluestein(int num_frames, double* x, double* y) const;
+
   //
   const int num_order_;
 
@@ -89,13 +112,46 @@ class FastFourierTransform {
   const int fft_length_;
 
   //
-  const int half_fft_length_;
+  Algorithms algorithm_;
 
   //
   bool is_valid_;
 
   //
-  std::vector<double> sine_table_;
+  int max_radix_;
+
+  //
+  std::vector<int> radices_;
+
+  //
+  std::vector<std::vector<double> > stage_cosine_tables_;
+
+  //
+  std::vector<std::vector<double> > stage_sine_tables_;
+
+  //
+  std::vector<std::vector<double> > radix_cosine_tables_;
+
+  //
+  std::vector<std::vector<double> > radix_sine_tables_;
+
+  //
+  std::vector<int> digit_reversal_swap_table_;
+
+  //
+  std::vector<double> chirp_real_part_;
+
+  //
+  std::vector<double> chirp_imaginary_part_;
+
+  //
+  std::vector<double> chirp_filter_real_part_;
+
+  //
+  std::vector<double> chirp_filter_imaginary_part_;
+
+  //
+  FastFourierTransform* bluestein_fast_fourier_transform_;
 
   //
   DISALLOW_COPY_AND_ASSIGN(FastFourierTransform);
@@ -48,6 +48,7 @@
 #include <vector>  // std::vector
 
 #include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -64,6 +65,10 @@ class FastFourierTransformForRealSequence {
    private:
     std::vector<double> real_part_input_;
     std::vector<double> imaginary_part_input_;
+    sptk::Matrix real_part_inputs_;
+    sptk::Matrix imaginary_part_inputs_;
+    sptk::Matrix real_part_outputs_;
+    sptk::Matrix imaginary_part_outputs_;
     friend class FastFourierTransformForRealSequence;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -71,6 +76,11 @@ class FastFourierTransformForRealSequence {
   //
   FastFourierTransformForRealSequence(int num_order, int fft_length);
 
+  // If half_length_output is true, only the first N/2+1 bins of the spectrum
+  // are computed and output.
+  FastFourierTransformForRealSequence(int num_order, int fft_length,
+                                      bool half_length_output);
+
   //
   virtual ~FastFourierTransformForRealSequence() {
   }
@@ -85,6 +95,16 @@ class FastFourierTransformForRealSequence {
     return fft_length_;
   }
 
+  //
+  bool IsHalfLengthOutput() const {
+    return half_length_output_;
+  }
+
+  //
+  int GetOutputLength() const {
+    return output_length_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -96,7 +116,15 @@ class FastFourierTransformForRealSequence {
            std::vector<double>* imaginary_part_output,
            FastFourierTransformForRealSequence::Buffer* buffer) const;
 
+  // Transform each row of the input matrix, i.e., each frame.
+  bool Run(const sptk::Matrix& real_part_input, sptk::Matrix* real_part_output,
+           sptk::Matrix* imaginary_part_output,
+           FastFourierTransformForRealSequence::Buffer* buffer) const;
+
  private:
+  //
+  void UnpackSpectrum(double* x, double* y) const;
+
   //
   const int num_order_;
 
@@ -106,6 +134,12 @@ class FastFourierTransformForRealSequence {
   //
   const int half_fft_length_;
 
+  //
+  const bool half_length_output_;
+
+  //
+  const int output_length_;
+
   //
   const FastFourierTransform fast_fourier_transform_;
 
@@ -115,6 +149,9 @@ class FastFourierTransformForRealSequence {
   //
   std::vector<double> sine_table_;
 
+  //
+  std::vector<double> cosine_table_;
+
   //
   DISALLOW_COPY_AND_ASSIGN(FastFourierTransformForRealSequence);
 };
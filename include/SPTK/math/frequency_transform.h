@@ -47,6 +47,7 @@
 
 #include <vector>  // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
@@ -70,6 +71,13 @@ class FrequencyTransform {
   //
   FrequencyTransform(int num_input_order, int num_output_order, double alpha);
 
+  // For a fixed all-pass constant the transform is a linear map. If
+  // use_warping_matrix is true, its matrix is computed here and each frame is
+  // transformed by a matrix-vector product instead of the recursion. The
+  // matrix is not used if it would have more than 2^22 elements.
+  FrequencyTransform(int num_input_order, int num_output_order, double alpha,
+                     bool use_warping_matrix);
+
   //
   virtual ~FrequencyTransform() {
   }
@@ -89,6 +97,11 @@ class FrequencyTransform {
     return alpha_;
   }
 
+  //
+  bool GetWarpingMatrixFlag() const {
+    return use_warping_matrix_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -99,7 +112,20 @@ class FrequencyTransform {
            std::vector<double>* warped_sequence,
            FrequencyTransform::Buffer* buffer) const;
 
+  // Transform each row of the input matrix, i.e., each frame. With the
+  // warping matrix, this is a single matrix-matrix product.
+  bool Run(const sptk::Matrix& minimum_phase_sequences,
+           sptk::Matrix* warped_sequences,
+           FrequencyTransform::Buffer* buffer) const;
+
  private:
+  //
+  void RunRecursion(const double* input, double* output,
+                    FrequencyTransform::Buffer* buffer) const;
+
+  //
+  void RunMatrixVectorProduct(const double* input, double* output) const;
+
   //
   const int num_input_order_;
 
@@ -109,9 +135,16 @@ class FrequencyTransform {
   //
   const double alpha_;
 
+  //
+  bool use_warping_matrix_;
+
   //
   bool is_valid_;
 
+  // Transposed warping matrix, i.e., the (m+1)x(M+1) matrix whose i-th row is
+  // the warped sequence of the i-th unit vector.
+  sptk::Matrix warping_matrix_;
+
   //
   DISALLOW_COPY_AND_ASSIGN(FrequencyTransform);
 };
@@ -70,6 +70,10 @@ class InverseFastFourierTransformForRealSequence {
   //
   InverseFastFourierTransformForRealSequence(int num_order, int fft_length);
 
+  //
+  InverseFastFourierTransformForRealSequence(int num_order, int fft_length,
+                                             bool half_length_output);
+
   //
   virtual ~InverseFastFourierTransformForRealSequence() {
   }
@@ -84,6 +88,16 @@ class InverseFastFourierTransformForRealSequence {
     return fast_fourier_transform_.GetFftLength();
   }
 
+  //
+  bool IsHalfLengthOutput() const {
+    return fast_fourier_transform_.IsHalfLengthOutput();
+  }
+
+  //
+  int GetOutputLength() const {
+    return fast_fourier_transform_.GetOutputLength();
+  }
+
   //
   bool IsValid() const {
     return fast_fourier_transform_.IsValid();
@@ -105,6 +105,10 @@ class Matrix {
   //
   Matrix operator*(const Matrix& matrix) const;
 
+  // Compute the product of this matrix and the given one without allocating
+  // memory if the output matrix already has the right size.
+  bool Multiply(const Matrix& matrix, Matrix* product) const;
+
   //
   void FillZero();
 
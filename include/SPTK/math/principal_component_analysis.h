@@ -66,14 +66,28 @@ class PrincipalComponentAnalysis {
    private:
     StatisticsAccumulator::Buffer accumulator_buffer_;
     SymmetricMatrix a_;
+    Matrix b_;
+    Matrix basis_vectors_;
+    Matrix transposed_basis_vectors_;
+    Matrix projected_vectors_;
+    Matrix ritz_vectors_;
+    Matrix projected_ritz_vectors_;
+    Matrix rotation_matrix_;
+    Matrix sorted_rotation_matrix_;
+    std::vector<double> eigenvalues_;
+    std::vector<double> off_diagonal_elements_;
     std::vector<int> eigenvalue_order_;
     friend class PrincipalComponentAnalysis;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
 
   //
-  PrincipalComponentAnalysis(int num_order, int num_iteration,
-                             double convergence_threshold);
+  enum Algorithms { kHouseholderQl = 0, kSubspaceIteration, kNumAlgorithms };
+
+  //
+  PrincipalComponentAnalysis(int num_order, int num_principal_component,
+                             int num_iteration, double convergence_threshold,
+                             Algorithms algorithm);
 
   //
   virtual ~PrincipalComponentAnalysis() {
@@ -84,6 +98,11 @@ class PrincipalComponentAnalysis {
     return num_order_;
   }
 
+  //
+  int GetNumPrincipalComponent() const {
+    return num_principal_component_;
+  }
+
   //
   int GetNumIteration() const {
     return num_iteration_;
@@ -94,27 +113,75 @@ class PrincipalComponentAnalysis {
     return convergence_threshold_;
   }
 
+  //
+  Algorithms GetAlgorithm() const {
+    return algorithm_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
   }
 
+  //
+  void Clear(PrincipalComponentAnalysis::Buffer* buffer) const {
+    if (NULL != buffer) accumulator_.Clear(&buffer->accumulator_buffer_);
+  }
+
   //
   bool Run(const std::vector<std::vector<double> >& input_vectors,
            std::vector<double>* mean_vector, std::vector<double>* eigenvalues,
            Matrix* eigenvector_matrix,
            PrincipalComponentAnalysis::Buffer* buffer) const;
 
+  // Accumulate statistics of the given rows. Only the statistics are kept in
+  // the buffer, so the memory usage does not depend on the number of inputs.
+  bool Run(const Matrix& input_vectors,
+           PrincipalComponentAnalysis::Buffer* buffer) const;
+
+  // Compute principal components from the statistics accumulated so far. It
+  // can be called repeatedly as data arrive; subspace iteration then starts
+  // from the principal components found in the previous call. The component
+  // of the largest magnitude in each eigenvector is made positive.
+  bool Decompose(std::vector<double>* mean_vector,
+                 std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+                 PrincipalComponentAnalysis::Buffer* buffer) const;
+
+  //
+  bool GetNumData(const PrincipalComponentAnalysis::Buffer& buffer,
+                  int* num_data) const;
+
+  // Get the sum of all eigenvalues, i.e., the trace of the covariance matrix
+  // calculated in the last call of Decompose.
+  bool GetTotalVariance(const PrincipalComponentAnalysis::Buffer& buffer,
+                        double* total_variance) const;
+
  private:
+  //
+  bool RunHouseholderQl(std::vector<double>* eigenvalues,
+                        Matrix* eigenvector_matrix,
+                        PrincipalComponentAnalysis::Buffer* buffer) const;
+
+  //
+  bool RunSubspaceIteration(std::vector<double>* eigenvalues,
+                            Matrix* eigenvector_matrix,
+                            PrincipalComponentAnalysis::Buffer* buffer) const;
+
   //
   const int num_order_;
 
+  //
+  const int num_principal_component_;
+
   //
   const int num_iteration_;
 
   //
   const double convergence_threshold_;
 
+  //
+  const Algorithms algorithm_;
+
   //
   const StatisticsAccumulator accumulator_;
 
@@ -59,7 +59,20 @@ class ScalarOperation {
     virtual ~ModuleInterface() {
     }
 
-    virtual bool Run(double* number, bool* is_magic_number) const = 0;
+    virtual bool Run(int num_data, double* numbers,
+                     bool* is_magic_numbers) const = 0;
+
+    // Merge the following addition into this module if this module can
+    // perform it in the same pass without changing the result.
+    virtual bool MergeAddition(double) {
+      return false;
+    }
+
+    // Merge the following multiplication into this module if this module can
+    // perform it in the same pass without changing the result.
+    virtual bool MergeMultiplication(double) {
+      return false;
+    }
   };
 
   //
@@ -165,6 +178,11 @@ class ScalarOperation {
   //
   bool Run(double* number, bool* is_magic_number) const;
 
+  // Perform the operations on num_data numbers in place. Each module processes
+  // the whole array before the next one. is_magic_numbers receives the flags
+  // of the numbers which are removed as magic numbers.
+  bool Run(int num_data, double* numbers, bool* is_magic_numbers) const;
+
  private:
   //
   bool use_magic_number_;
@@ -46,8 +46,10 @@
 #define SPTK_MATH_STATISTICS_ACCUMULATOR_H_
 
 #include <algorithm>  // std::fill
+#include <iostream>   // std::istream, std::ostream
 #include <vector>     // std::vector
 
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/symmetric_matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -67,12 +69,24 @@ class StatisticsAccumulator {
       zeroth_order_statistics_ = 0;
       std::fill(first_order_statistics_.begin(), first_order_statistics_.end(),
                 0.0);
+      std::fill(compensation_for_first_order_statistics_.begin(),
+                compensation_for_first_order_statistics_.end(), 0.0);
       second_order_statistics_.FillZero();
+      compensation_for_second_order_statistics_.FillZero();
     }
 
     int zeroth_order_statistics_;
     std::vector<double> first_order_statistics_;
+    // Sum of outer products of deviations from the mean.
     SymmetricMatrix second_order_statistics_;
+
+    // Low-order parts lost in the summations above.
+    std::vector<double> compensation_for_first_order_statistics_;
+    SymmetricMatrix compensation_for_second_order_statistics_;
+
+    std::vector<double> transposed_block_;
+    std::vector<double> sum_of_block_;
+    std::vector<double> delta_of_mean_;
     friend class StatisticsAccumulator;
     DISALLOW_COPY_AND_ASSIGN(Buffer);
   };
@@ -130,11 +144,36 @@ class StatisticsAccumulator {
   //
   void Clear(StatisticsAccumulator::Buffer* buffer) const;
 
+  // Add the statistics in the first buffer to those in the second one. It fails
+  // without changing the second buffer if the total number of data would not
+  // fit in int.
+  bool Merge(const StatisticsAccumulator::Buffer& buffer_to_be_merged,
+             StatisticsAccumulator::Buffer* buffer) const;
+
   //
   bool Run(const std::vector<double>& data,
            StatisticsAccumulator::Buffer* buffer) const;
 
+  // Accumulate the statistics of the rows of the given matrix.
+  bool Run(const Matrix& data, StatisticsAccumulator::Buffer* buffer) const;
+
+  // Write the statistics as a sequence of doubles: the number of data, the
+  // length of vector, the sum, and the lower triangle of the second-order
+  // statistics.
+  bool WriteStatistics(const StatisticsAccumulator::Buffer& buffer,
+                       std::ostream* output_stream) const;
+
+  // Read the statistics written by WriteStatistics. If the stream ends before
+  // the record, false is returned and is_end_of_stream is set to true. A short
+  // or inconsistent record returns false with is_end_of_stream set to false.
+  bool ReadStatistics(std::istream* input_stream,
+                      StatisticsAccumulator::Buffer* buffer,
+                      bool* is_end_of_stream) const;
+
  private:
+  //
+  void PrepareBuffer(StatisticsAccumulator::Buffer* buffer) const;
+
   //
   const int num_order_;
 
@@ -122,6 +122,9 @@ class SymmetricMatrix {
 
   //
   std::vector<double*> index_;
+
+  //
+  friend class CholeskyDecomposition;
 };
 
 }  // namespace sptk
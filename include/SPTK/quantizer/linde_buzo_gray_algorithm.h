@@ -62,6 +62,14 @@ class LindeBuzoGrayAlgorithm {
                          int minimum_num_vector_in_cluster, int num_iteration,
                          double convergence_threshold, double splitting_factor);
 
+  // The E-step is run with num_thread threads. The result is deterministic
+  // for a fixed seed and number of threads.
+  LindeBuzoGrayAlgorithm(int num_order, int seed, int initial_codebook_size,
+                         int target_codebook_size,
+                         int minimum_num_vector_in_cluster, int num_iteration,
+                         double convergence_threshold, double splitting_factor,
+                         int num_thread);
+
   //
   virtual ~LindeBuzoGrayAlgorithm() {
   }
@@ -106,6 +114,11 @@ class LindeBuzoGrayAlgorithm {
     return splitting_factor_;
   }
 
+  //
+  int GetNumThread() const {
+    return num_thread_;
+  }
+
   //
   bool IsValid() const {
     return is_valid_;
@@ -117,6 +130,14 @@ class LindeBuzoGrayAlgorithm {
            std::vector<int>* codebook_index) const;
 
  private:
+  //
+  bool AccumulateStatistics(
+      const std::vector<std::vector<double> >& input_vectors,
+      const std::vector<std::vector<double> >& codebook_vectors,
+      const VectorQuantization::Buffer& buffer_for_vector_quantization,
+      int begin, int end, std::vector<int>* codebook_index,
+      StatisticsAccumulator::Buffer* buffers, double* total_distance) const;
+
   //
   const int num_order_;
 
@@ -141,6 +162,9 @@ class LindeBuzoGrayAlgorithm {
   //
   const double splitting_factor_;
 
+  //
+  const int num_thread_;
+
   //
   const DistanceCalculator distance_calculator_;
 
@@ -54,6 +54,20 @@ namespace sptk {
 
 class VectorQuantization {
  public:
+  class Buffer {
+   public:
+    Buffer() {
+    }
+    virtual ~Buffer() {
+    }
+
+   private:
+    std::vector<double> codebook_vectors_;
+    std::vector<double> norms_;
+    friend class VectorQuantization;
+    DISALLOW_COPY_AND_ASSIGN(Buffer);
+  };
+
   //
   explicit VectorQuantization(int num_order);
 
@@ -76,6 +90,17 @@ class VectorQuantization {
            const std::vector<std::vector<double> >& codebook_vectors,
            int* codebook_index) const;
 
+  // Store the codebook in the buffer with the norms of codebook vectors. This
+  // must be called again whenever the codebook is modified.
+  bool SetCodebook(const std::vector<std::vector<double> >& codebook_vectors,
+                   VectorQuantization::Buffer* buffer) const;
+
+  // Search the codebook stored in the buffer. The result is identical to that
+  // of the exhaustive search.
+  bool Run(const std::vector<double>& input_vector,
+           const VectorQuantization::Buffer& buffer,
+           int* codebook_index) const;
+
  private:
   //
   const int num_order_;
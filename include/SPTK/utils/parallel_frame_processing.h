@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+#ifndef SPTK_UTILS_PARALLEL_FRAME_PROCESSING_H_
+#define SPTK_UTILS_PARALLEL_FRAME_PROCESSING_H_
+
+#include <functional>  // std::function
+#include <istream>     // std::istream
+#include <vector>      // std::vector
+
+#include "SPTK/math/matrix.h"
+#include "SPTK/utils/sptk_utils.h"
+
+namespace sptk {
+
+// Apply a function to independent fixed-length frames using multiple threads.
+// Frames are read from a stream in large batches, each thread processes a
+// contiguous block of a batch, and the results are passed to a writer in the
+// original order. Reading and writing are overlapped with processing, and the
+// threads are kept alive until all batches have been processed.
+class ParallelFrameProcessing {
+ public:
+  // Process one frame. This is called from several threads at once, so it
+  // must use the buffer owned by the given thread index.
+  typedef std::function<bool(const std::vector<double>& input_frame,
+                             std::vector<double>* output_frame,
+                             int thread_index)>
+      FrameProcessor;
+
+  // Process a block of frames stored one per row. This is called from several
+  // threads at once, so it must use the buffer owned by the given thread
+  // index. The output must have one row of output length per input frame.
+  typedef std::function<bool(const Matrix& input_frames, Matrix* output_frames,
+                             int thread_index)>
+      BlockProcessor;
+
+  // Write one processed frame. This is called on the calling thread in the
+  // order of input frames.
+  typedef std::function<bool(const std::vector<double>& output_frame)>
+      FrameWriter;
+
+  //
+  ParallelFrameProcessing(int input_length, int output_length, int num_thread,
+                          bool zero_padding);
+
+  //
+  virtual ~ParallelFrameProcessing() {
+  }
+
+  //
+  int GetInputLength() const {
+    return input_length_;
+  }
+
+  //
+  int GetOutputLength() const {
+    return output_length_;
+  }
+
+  //
+  int GetNumThread() const {
+    return num_thread_;
+  }
+
+  //
+  bool GetZeroPaddingFlag() const {
+    return zero_padding_;
+  }
+
+  //
+  bool IsValid() const {
+    return is_valid_;
+  }
+
+  // Process all frames in the input stream. If processing or writing a frame
+  // fails, the preceding frames have been written and false is returned.
+  bool Run(const FrameProcessor& frame_processor,
+           const FrameWriter& frame_writer, std::istream* input_stream) const;
+
+  // Process all frames in the input stream block by block. If processing a
+  // block or writing a frame fails, the frames of the preceding blocks have
+  // been written and false is returned.
+  bool Run(const BlockProcessor& block_processor,
+           const FrameWriter& frame_writer, std::istream* input_stream) const;
+
+ private:
+  // Process a block of frames and return the number of leading frames
+  // processed successfully.
+  typedef std::function<int(const Matrix& input_frames, Matrix* output_frames,
+                            int thread_index)>
+      BlockTask;
+
+  //
+  bool RunBlockTask(const BlockTask& block_task,
+                    const FrameWriter& frame_writer,
+                    std::istream* input_stream) const;
+
+  //
+  const int input_length_;
+
+  //
+  const int output_length_;
+
+  //
+  const int num_thread_;
+
+  //
+  const bool zero_padding_;
+
+  //
+  bool is_valid_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(ParallelFrameProcessing);
+};
+
+}  // namespace sptk
+
+#endif  // SPTK_UTILS_PARALLEL_FRAME_PROCESSING_H_
@@ -45,10 +45,13 @@
 #ifndef SPTK_UTILS_SPTK_UTILS_H_
 #define SPTK_UTILS_SPTK_UTILS_H_
 
-#include <iostream>  // std::istream, std::ostream
-#include <sstream>   // std::ostringstream
-#include <string>    // std::string
-#include <vector>    // std::vector
+#include <algorithm>  // std::min
+#include <cstddef>    // std::size_t
+#include <cstring>    // std::memcpy
+#include <iostream>   // std::istream, std::ostream
+#include <sstream>    // std::ostringstream
+#include <string>     // std::string
+#include <vector>     // std::vector
 
 #include "SPTK/math/matrix.h"
 
@@ -91,6 +94,8 @@ const char* ConvertBooleanToString(bool input);
 bool ConvertStringToInteger(const std::string& input, int* output);
 bool ConvertStringToDouble(const std::string& input, double* output);
 bool ConvertSpecialStringToDouble(const std::string& input, double* output);
+bool ConvertLeadingStringToLongDouble(const std::string& input,
+                                      long double* output);
 bool IsInRange(int num, int min, int max);
 bool IsInRange(double num, double min, double max);
 bool IsPowerOfTwo(int num);
@@ -109,6 +114,149 @@ void PrintDataType(const std::string& symbol, std::ostream* stream);
 void PrintErrorMessage(const std::string& program_name,
                        const std::ostringstream& message);
 
+// Read binary data from a stream through a large internal buffer. The stream
+// should not be read by other means while this reader is in use.
+class BufferedStreamReader {
+ public:
+  //
+  explicit BufferedStreamReader(std::istream* input_stream);
+
+  //
+  virtual ~BufferedStreamReader() {
+  }
+
+  //
+  template <typename T>
+  bool Read(T* data_to_read) {
+    const std::size_t type_byte(sizeof(*data_to_read));
+    if (NULL == data_to_read ||
+        (tail_ - head_ < type_byte && !Fill(type_byte))) {
+      return false;
+    }
+    // Copy through void* since 24-bit integer types are not trivially copyable.
+    std::memcpy(static_cast<void*>(data_to_read), &(buffer_[head_]), type_byte);
+    head_ += type_byte;
+    return true;
+  }
+
+  //
+  template <typename T>
+  bool Read(int read_size, T* sequence_to_read, int* actual_read_size) {
+    if (read_size <= 0 || NULL == sequence_to_read) {
+      return false;
+    }
+
+    const std::size_t type_byte(sizeof(*sequence_to_read));
+    int num_read(0);
+    while (num_read < read_size &&
+           (type_byte <= tail_ - head_ || Fill(type_byte))) {
+      const int num_copy(
+          std::min(read_size - num_read,
+                   static_cast<int>((tail_ - head_) / type_byte)));
+      std::memcpy(static_cast<void*>(sequence_to_read + num_read),
+                  &(buffer_[head_]), type_byte * num_copy);
+      head_ += type_byte * num_copy;
+      num_read += num_copy;
+    }
+
+    if (NULL != actual_read_size) {
+      *actual_read_size = num_read;
+    }
+    return num_read == read_size;
+  }
+
+  // Read a word separated by white spaces as operator>> does. Return false if
+  // no word is left in the stream.
+  bool ReadWord(std::string* word);
+
+ private:
+  // Read from the stream until at least num_bytes bytes are buffered.
+  bool Fill(std::size_t num_bytes);
+
+  //
+  std::istream* input_stream_;
+
+  //
+  std::vector<char> buffer_;
+
+  //
+  std::size_t head_;
+
+  //
+  std::size_t tail_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(BufferedStreamReader);
+};
+
+// Write binary data to a stream through a large internal buffer. The buffered
+// data are written to the stream by Flush or on destruction.
+class BufferedStreamWriter {
+ public:
+  //
+  explicit BufferedStreamWriter(std::ostream* output_stream);
+
+  //
+  virtual ~BufferedStreamWriter() {
+    Flush();
+  }
+
+  //
+  template <typename T>
+  bool Write(T data_to_write) {
+    const std::size_t type_byte(sizeof(data_to_write));
+    if (buffer_.size() - size_ < type_byte && !Flush()) {
+      return false;
+    }
+    std::memcpy(&(buffer_[size_]), &data_to_write, type_byte);
+    size_ += type_byte;
+    return true;
+  }
+
+  //
+  template <typename T>
+  bool Write(int write_size, const T* sequence_to_write) {
+    if (write_size <= 0 || NULL == sequence_to_write) {
+      return false;
+    }
+
+    const std::size_t type_byte(sizeof(*sequence_to_write));
+    int num_written(0);
+    while (num_written < write_size) {
+      if (buffer_.size() - size_ < type_byte && !Flush()) {
+        return false;
+      }
+      const int num_copy(
+          std::min(write_size - num_written,
+                   static_cast<int>((buffer_.size() - size_) / type_byte)));
+      std::memcpy(&(buffer_[size_]), sequence_to_write + num_written,
+                  type_byte * num_copy);
+      size_ += type_byte * num_copy;
+      num_written += num_copy;
+    }
+    return true;
+  }
+
+  // Write a null-terminated string without the terminating null.
+  bool WriteString(const char* string_to_write);
+
+  //
+  bool Flush();
+
+ private:
+  //
+  std::ostream* output_stream_;
+
+  //
+  std::vector<char> buffer_;
+
+  //
+  std::size_t size_;
+
+  //
+  DISALLOW_COPY_AND_ASSIGN(BufferedStreamWriter);
+};
+
 }  // namespace sptk
 
 #endif  // SPTK_UTILS_SPTK_UTILS_H_
@@ -0,0 +1,286 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/analyzer/chunked_pitch_extraction.h"
+
+#include <algorithm>  // std::copy, std::min, std::max
+#include <cmath>      // std::ceil, std::log2, std::pow, std::round
+#include <thread>     // std::thread
+
+#include "SPTK/analyzer/pitch_extraction_by_rapt.h"
+
+namespace {
+
+// The context [sec] attached to both sides of a chunk. RAPT finds the best
+// path over the whole input by dynamic programming, so it needs longer context
+// than SWIPE' and WORLD which decide f0 almost locally. REAPER is unused.
+const double kContextInSeconds[] = {1.0, 0.1, 1.0, 0.3};
+
+// The number of periods of the minimum f0 added to the context to cover the
+// analysis windows.
+const double kNumPeriodInContext(4.0);
+
+// Return the number of frames to which the beginning of a waveform given to
+// SWIPE' is aligned. SWIPE' computes spectra every half window from the first
+// sample, where the longest window is determined by the minimum f0.
+int GetAlignmentForSwipe(int frame_shift, double sampling_rate,
+                         double minimum_f0) {
+  const int hop_size(static_cast<int>(
+      std::pow(2.0, std::round(std::log2(8.0 * sampling_rate / minimum_f0)))) /
+                     2);
+  int a(hop_size), b(frame_shift);
+  while (0 != b) {
+    const int r(a % b);
+    a = b;
+    b = r;
+  }
+  return hop_size / a;
+}
+
+struct Chunk {
+  // The waveform of the chunk with its context.
+  std::vector<double> waveform;
+  // The number of frames in the left context.
+  int num_context_frame;
+  // The number of frames in the chunk.
+  int num_frame;
+  // The time [sec] of the first sample of the waveform.
+  double start_time;
+  // The time range [sec] of the chunk.
+  double begin_time;
+  double end_time;
+  std::vector<double> f0;
+  std::vector<double> epochs;
+  bool is_succeeded;
+};
+
+void ProcessChunk(const sptk::PitchExtraction& pitch_extraction,
+                  bool extract_f0, bool extract_epochs, Chunk* chunk) {
+  std::vector<double> f0;
+  std::vector<double> epochs;
+  chunk->is_succeeded = pitch_extraction.Run(
+      chunk->waveform, extract_f0 ? &f0 : NULL,
+      extract_epochs ? &epochs : NULL, NULL);
+  if (!chunk->is_succeeded) return;
+
+  if (extract_f0) {
+    const int end(chunk->num_context_frame + chunk->num_frame);
+    if (static_cast<int>(f0.size()) < end) {
+      chunk->is_succeeded = false;
+      return;
+    }
+    chunk->f0.assign(f0.begin() + chunk->num_context_frame, f0.begin() + end);
+  }
+
+  if (extract_epochs) {
+    chunk->epochs.clear();
+    for (std::vector<double>::const_iterator itr(epochs.begin());
+         itr != epochs.end(); ++itr) {
+      const double time(chunk->start_time + *itr);
+      if (chunk->begin_time <= time && time < chunk->end_time) {
+        chunk->epochs.push_back(time);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+namespace sptk {
+
+ChunkedPitchExtraction::ChunkedPitchExtraction(
+    int frame_shift, double sampling_rate, double minimum_f0,
+    double maximum_f0, double voicing_threshold,
+    PitchExtraction::Algorithms algorithm, int chunk_length, int num_thread)
+    : frame_shift_(frame_shift),
+      sampling_rate_(sampling_rate),
+      chunk_length_(chunk_length),
+      num_thread_(num_thread),
+      algorithm_(algorithm),
+      pitch_extraction_(frame_shift, sampling_rate, minimum_f0, maximum_f0,
+                        voicing_threshold, algorithm,
+                        PitchExtraction::kRapt == algorithm),
+      context_length_(0),
+      alignment_(1),
+      is_valid_(true) {
+  if (chunk_length_ <= 0 || num_thread_ <= 0 ||
+      PitchExtraction::kReaper == algorithm_ ||
+      !pitch_extraction_.IsValid()) {
+    is_valid_ = false;
+    return;
+  }
+
+  context_length_ = CalculateContextLength(frame_shift_, sampling_rate_,
+                                           minimum_f0, algorithm);
+  alignment_ =
+      CalculateAlignment(frame_shift_, sampling_rate_, minimum_f0, algorithm);
+}
+
+int ChunkedPitchExtraction::CalculateContextLength(
+    int frame_shift, double sampling_rate, double minimum_f0,
+    PitchExtraction::Algorithms algorithm) {
+  const double context_in_seconds(kContextInSeconds[algorithm] +
+                                  kNumPeriodInContext / minimum_f0);
+  return static_cast<int>(
+      std::ceil(context_in_seconds * sampling_rate / frame_shift));
+}
+
+int ChunkedPitchExtraction::CalculateAlignment(
+    int frame_shift, double sampling_rate, double minimum_f0,
+    PitchExtraction::Algorithms algorithm) {
+  if (PitchExtraction::kSwipe == algorithm) {
+    return GetAlignmentForSwipe(frame_shift, sampling_rate, minimum_f0);
+  }
+  return 1;
+}
+
+bool ChunkedPitchExtraction::Run(const F0Writer& f0_writer,
+                                 const EpochWriter& epoch_writer,
+                                 std::istream* input_stream) const {
+  if (!is_valid_ || NULL == input_stream) {
+    return false;
+  }
+
+  const bool extract_f0(static_cast<bool>(f0_writer));
+  const bool extract_epochs(static_cast<bool>(epoch_writer));
+  std::vector<Chunk> chunks(num_thread_);
+
+  // The buffer holds the waveform from the first sample of the frame
+  // buffer_begin. The frames are counted globally.
+  std::vector<double> buffer;
+  int buffer_begin(0);
+  bool is_end_of_stream(false);
+
+  // Each sample is dithered once when it is read.
+  PitchExtractionByRapt::Buffer dither_buffer;
+
+  for (int chunk_begin(0);; chunk_begin += chunk_length_ * num_thread_) {
+    // read the waveform required by the chunks in this round
+    const int round_end(chunk_begin + chunk_length_ * num_thread_);
+    const int required_size((round_end + context_length_ - buffer_begin) *
+                            frame_shift_);
+    const int current_size(buffer.size());
+    if (!is_end_of_stream && current_size < required_size) {
+      buffer.resize(required_size);
+      input_stream->read(reinterpret_cast<char*>(&(buffer[current_size])),
+                         sizeof(buffer[0]) * (required_size - current_size));
+      const int num_read(input_stream->gcount() / sizeof(buffer[0]));
+      if (num_read < required_size - current_size) {
+        is_end_of_stream = true;
+      }
+      buffer.resize(current_size + num_read);
+      if (PitchExtraction::kRapt == algorithm_ && 0 < num_read &&
+          !PitchExtractionByRapt::Dither(num_read, &(buffer[current_size]),
+                                         &dither_buffer)) {
+        return false;
+      }
+    }
+
+    // the number of frames available in this round
+    const int buffer_end(
+        is_end_of_stream
+            ? buffer_begin + (buffer.size() + frame_shift_ - 1) / frame_shift_
+            : round_end);
+
+    // prepare chunks
+    int num_chunk(0);
+    for (int begin(chunk_begin); begin < std::min(round_end, buffer_end);
+         begin += chunk_length_, ++num_chunk) {
+      const int end(std::min(begin + chunk_length_, buffer_end));
+      const int context_begin(
+          std::max(0, begin - context_length_) / alignment_ * alignment_);
+      const int waveform_begin((context_begin - buffer_begin) * frame_shift_);
+      const int waveform_end(
+          std::min(static_cast<int>(buffer.size()),
+                   (end + context_length_ - buffer_begin) * frame_shift_));
+
+      Chunk& chunk(chunks[num_chunk]);
+      chunk.waveform.assign(buffer.begin() + waveform_begin,
+                            buffer.begin() + waveform_end);
+      chunk.num_context_frame = begin - context_begin;
+      chunk.num_frame = end - begin;
+      chunk.start_time = context_begin * frame_shift_ / sampling_rate_;
+      chunk.begin_time = begin * frame_shift_ / sampling_rate_;
+      chunk.end_time = end * frame_shift_ / sampling_rate_;
+    }
+    if (0 == num_chunk) break;
+
+    // extract pitch
+    if (1 == num_chunk) {
+      ProcessChunk(pitch_extraction_, extract_f0, extract_epochs, &chunks[0]);
+    } else {
+      std::vector<std::thread> threads;
+      for (int i(0); i < num_chunk; ++i) {
+        threads.push_back(std::thread(ProcessChunk,
+                                      std::cref(pitch_extraction_), extract_f0,
+                                      extract_epochs, &chunks[i]));
+      }
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+
+    // write results in order
+    for (int i(0); i < num_chunk; ++i) {
+      if (!chunks[i].is_succeeded ||
+          (extract_f0 && !f0_writer(chunks[i].f0)) ||
+          (extract_epochs && !epoch_writer(chunks[i].epochs))) {
+        return false;
+      }
+    }
+    if (is_end_of_stream && buffer_end <= round_end) break;
+
+    // discard the waveform no longer needed
+    const int next_buffer_begin(std::max(0, round_end - context_length_) /
+                                alignment_ * alignment_);
+    buffer.erase(buffer.begin(),
+                 buffer.begin() + (next_buffer_begin - buffer_begin) *
+                                      frame_shift_);
+    buffer_begin = next_buffer_begin;
+  }
+
+  return true;
+}
+
+}  // namespace sptk
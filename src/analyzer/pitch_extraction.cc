@@ -54,12 +54,21 @@ namespace sptk {
 PitchExtraction::PitchExtraction(int frame_shift, double sampling_rate,
                                  double minimum_f0, double maximum_f0,
                                  double voicing_threshold,
-                                 PitchExtraction::Algorithms algorithm) {
+                                 PitchExtraction::Algorithms algorithm)
+    : PitchExtraction(frame_shift, sampling_rate, minimum_f0, maximum_f0,
+                      voicing_threshold, algorithm, false) {
+}
+
+PitchExtraction::PitchExtraction(int frame_shift, double sampling_rate,
+                                 double minimum_f0, double maximum_f0,
+                                 double voicing_threshold,
+                                 PitchExtraction::Algorithms algorithm,
+                                 bool dithered_input_flag) {
   switch (algorithm) {
     case kRapt: {
-      pitch_extractor_ =
-          new PitchExtractionByRapt(frame_shift, sampling_rate, minimum_f0,
-                                    maximum_f0, voicing_threshold);
+      pitch_extractor_ = new PitchExtractionByRapt(
+          frame_shift, sampling_rate, minimum_f0, maximum_f0,
+          voicing_threshold, dithered_input_flag);
       break;
     }
     case kSwipe: {
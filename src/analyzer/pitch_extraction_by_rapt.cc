@@ -46,9 +46,20 @@
 
 #include <algorithm>  // std::copy, std::fill
 #include <cmath>      // std::ceil
+#include <mutex>      // std::lock_guard, std::mutex
 
 #include "Snack/generic/jkGetF0.h"
 
+namespace {
+
+// Snack keeps its working memory in static variables.
+std::mutex snack_mutex;
+
+// The standard deviation of the dither.
+const double kDitherStandardDeviation(50.0);
+
+}  // namespace
+
 namespace sptk {
 
 PitchExtractionByRapt::PitchExtractionByRapt(int frame_shift,
@@ -56,11 +67,22 @@ PitchExtractionByRapt::PitchExtractionByRapt(int frame_shift,
                                              double minimum_f0,
                                              double maximum_f0,
                                              double voicing_threshold)
+    : PitchExtractionByRapt(frame_shift, sampling_rate, minimum_f0,
+                            maximum_f0, voicing_threshold, false) {
+}
+
+PitchExtractionByRapt::PitchExtractionByRapt(int frame_shift,
+                                             double sampling_rate,
+                                             double minimum_f0,
+                                             double maximum_f0,
+                                             double voicing_threshold,
+                                             bool dithered_input_flag)
     : frame_shift_(frame_shift),
       sampling_rate_(sampling_rate),
       minimum_f0_(minimum_f0),
       maximum_f0_(maximum_f0),
       voicing_threshold_(voicing_threshold),
+      dithered_input_flag_(dithered_input_flag),
       is_valid_(true) {
   if (frame_shift_ <= 0 || sampling_rate_ / 2 <= maximum_f0_ ||
       (sampling_rate_ <= 6000.0 || 98000.0 <= sampling_rate_) ||
@@ -79,9 +101,21 @@ bool PitchExtractionByRapt::Get(
   }
 
   if (NULL != f0) {
+    std::vector<double> dithered_waveform;
+    if (!dithered_input_flag_) {
+      dithered_waveform = waveform;
+      PitchExtractionByRapt::Buffer buffer;
+      if (!Dither(dithered_waveform.size(), &(dithered_waveform[0]),
+                  &buffer)) {
+        return false;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(snack_mutex);
     float* tmp_f0;
     int tmp_length;
-    if (0 != snack::cGet_f0(waveform, frame_shift_, sampling_rate_, minimum_f0_,
+    if (0 != snack::cGet_f0(dithered_input_flag_ ? waveform : dithered_waveform,
+                            frame_shift_, sampling_rate_, minimum_f0_,
                             maximum_f0_, voicing_threshold_, &tmp_f0,
                             &tmp_length)) {
       return false;
@@ -108,4 +142,22 @@ bool PitchExtractionByRapt::Get(
   return true;
 }
 
+bool PitchExtractionByRapt::Dither(int num_sample, double* waveform,
+                                   PitchExtractionByRapt::Buffer* buffer) {
+  if (num_sample < 0 || (0 < num_sample && NULL == waveform) ||
+      NULL == buffer) {
+    return false;
+  }
+
+  double noise;
+  for (int i(0); i < num_sample; ++i) {
+    if (!buffer->generator_.Get(&noise)) {
+      return false;
+    }
+    waveform[i] += noise * kDitherStandardDeviation;
+  }
+
+  return true;
+}
+
 }  // namespace sptk
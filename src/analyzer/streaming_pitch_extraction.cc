@@ -0,0 +1,151 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/analyzer/streaming_pitch_extraction.h"
+
+#include <algorithm>  // std::max
+#include <cmath>      // std::ceil
+
+#include "SPTK/analyzer/pitch_extraction_by_swipe.h"
+#include "SWIPE/src/swipe.h"
+
+namespace sptk {
+
+StreamingPitchExtraction::Buffer::Buffer()
+    : swipe_buffer_(new swipe::StreamingSwipeBuffer()),
+      num_sample_(0),
+      num_frame_(0),
+      last_f0_(0.0) {
+}
+
+StreamingPitchExtraction::Buffer::~Buffer() {
+  delete swipe_buffer_;
+}
+
+StreamingPitchExtraction::StreamingPitchExtraction(
+    int frame_shift, double sampling_rate, double minimum_f0,
+    double maximum_f0, double voicing_threshold,
+    PitchExtraction::Algorithms algorithm)
+    : frame_shift_(frame_shift), swipe_(NULL), is_valid_(true) {
+  if (PitchExtraction::kSwipe != algorithm ||
+      !PitchExtractionBySwipe(frame_shift_, sampling_rate, minimum_f0,
+                              maximum_f0, voicing_threshold)
+           .IsValid()) {
+    is_valid_ = false;
+    return;
+  }
+
+  swipe_ = new swipe::StreamingSwipe(
+      sampling_rate, minimum_f0, maximum_f0, voicing_threshold,
+      static_cast<double>(frame_shift_) / sampling_rate);
+}
+
+StreamingPitchExtraction::~StreamingPitchExtraction() {
+  delete swipe_;
+}
+
+int StreamingPitchExtraction::GetLatency() const {
+  return is_valid_ ? swipe_->GetLatency() : 0;
+}
+
+bool StreamingPitchExtraction::Push(const std::vector<double>& waveform,
+                                    StreamingPitchExtraction::Buffer* buffer)
+    const {
+  if (!is_valid_ || NULL == buffer) {
+    return false;
+  }
+
+  swipe_->Push(waveform, buffer->swipe_buffer_);
+  buffer->num_sample_ += static_cast<int>(waveform.size());
+
+  return true;
+}
+
+bool StreamingPitchExtraction::Pull(std::vector<double>* f0,
+                                    StreamingPitchExtraction::Buffer* buffer)
+    const {
+  if (!is_valid_ || NULL == f0 || NULL == buffer) {
+    return false;
+  }
+
+  swipe_->Pull(false, f0, buffer->swipe_buffer_);
+  if (!f0->empty()) {
+    buffer->num_frame_ += static_cast<int>(f0->size());
+    buffer->last_f0_ = f0->back();
+  }
+
+  return true;
+}
+
+bool StreamingPitchExtraction::Flush(std::vector<double>* f0,
+                                     StreamingPitchExtraction::Buffer* buffer)
+    const {
+  if (!is_valid_ || NULL == f0 || NULL == buffer) {
+    return false;
+  }
+
+  swipe_->Pull(true, f0, buffer->swipe_buffer_);
+  if (!f0->empty()) {
+    buffer->num_frame_ += static_cast<int>(f0->size());
+    buffer->last_f0_ = f0->back();
+  }
+
+  // adjust the number of frames as PitchExtractionBySwipe does
+  const int target_length(
+      std::ceil(static_cast<double>(buffer->num_sample_) / frame_shift_));
+  const int num_rest_frame(target_length - buffer->num_frame_);
+  if (num_rest_frame < 0) {
+    f0->resize(std::max(0, static_cast<int>(f0->size()) + num_rest_frame));
+  } else {
+    f0->insert(f0->end(), num_rest_frame, buffer->last_f0_);
+  }
+
+  buffer->num_sample_ = 0;
+  buffer->num_frame_ = 0;
+  buffer->last_f0_ = 0.0;
+
+  return true;
+}
+
+}  // namespace sptk
@@ -44,11 +44,14 @@
 
 #include "SPTK/converter/mel_generalized_cepstrum_to_mel_generalized_cepstrum.h"
 
-#include <algorithm>   // std::copy, std::transform
+#include <algorithm>   // std::copy, std::fill, std::transform
 #include <functional>  // std::bind1st, std::multiplies
+#include <sstream>     // std::ostringstream
+#include <string>      // std::string
 #include <vector>      // std::vector
 
 #include "SPTK/math/frequency_transform.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/normalizer/generalized_cepstrum_gain_normalization.h"
 #include "SPTK/normalizer/generalized_cepstrum_inverse_gain_normalization.h"
 
@@ -114,7 +117,7 @@ class FrequencyTransformModule
   FrequencyTransformModule(int num_input_order, int num_output_order,
                            double alpha_transform)
       : frequency_transform_(num_input_order, num_output_order,
-                             alpha_transform) {
+                             alpha_transform, true) {
   }
   virtual bool IsValid() const {
     return frequency_transform_.IsValid();
@@ -247,6 +250,328 @@ class GammaMultiplicationModule
   DISALLOW_COPY_AND_ASSIGN(GammaMultiplicationModule);
 };
 
+class LinearTransformModule
+    : public sptk::MelGeneralizedCepstrumToMelGeneralizedCepstrum::
+          ModuleInterface {
+ public:
+  explicit LinearTransformModule(const sptk::Matrix& matrix)
+      : num_input_order_(matrix.GetNumRow() - 1),
+        num_output_order_(matrix.GetNumColumn() - 1),
+        matrix_(matrix) {
+  }
+  virtual bool IsValid() const {
+    return 0 <= num_input_order_ && 0 <= num_output_order_;
+  }
+  virtual bool Run(
+      const std::vector<double>& input, std::vector<double>* output,
+      sptk::FrequencyTransform::Buffer* frequency_transform_buffer) const {
+    if (output->size() != static_cast<std::size_t>(num_output_order_ + 1)) {
+      output->resize(num_output_order_ + 1);
+    }
+    // accumulate scaled rows in the same order as sptk::Matrix::Multiply
+    double* c2(&((*output)[0]));
+    std::fill(output->begin(), output->end(), 0.0);
+    for (int i(0); i <= num_input_order_; ++i) {
+      const double c1(input[i]);
+      const double* w(matrix_[i]);
+      for (int j(0); j <= num_output_order_; ++j) {
+        c2[j] += c1 * w[j];
+      }
+    }
+    return true;
+  }
+
+ private:
+  const int num_input_order_;
+  const int num_output_order_;
+  const sptk::Matrix matrix_;
+  DISALLOW_COPY_AND_ASSIGN(LinearTransformModule);
+};
+
+// 32 MB in double precision.
+const int kMaxFusedMatrixSize(1 << 22);
+
+// A step of the conversion before it is turned into a module.
+struct Step {
+  enum Kind {
+    kGainNormalization,
+    kInverseGainNormalization,
+    kFrequencyTransform,
+    kGeneralizedCepstrumTransformation,
+    kGammaDivision,
+    kGammaMultiplication,
+    kLinearTransform,
+  };
+
+  Step(Kind kind, const std::string& name, int num_input_order,
+       int num_output_order)
+      : kind(kind),
+        name(name),
+        num_input_order(num_input_order),
+        num_output_order(num_output_order),
+        input_gamma(0.0),
+        output_gamma(0.0),
+        alpha(0.0) {
+  }
+
+  Kind kind;
+  std::string name;
+  int num_input_order;
+  int num_output_order;
+  double input_gamma;
+  double output_gamma;
+  double alpha;
+  // The fused map, i.e., output = input * matrix.
+  sptk::Matrix matrix;
+};
+
+Step GainNormalizationStep(int num_order, double gamma) {
+  Step step(Step::kGainNormalization, "gnorm", num_order, num_order);
+  step.input_gamma = gamma;
+  step.output_gamma = gamma;
+  return step;
+}
+
+Step InverseGainNormalizationStep(int num_order, double gamma) {
+  Step step(Step::kInverseGainNormalization, "ignorm", num_order, num_order);
+  step.input_gamma = gamma;
+  step.output_gamma = gamma;
+  return step;
+}
+
+Step FrequencyTransformStep(int num_input_order, int num_output_order,
+                            double alpha) {
+  Step step(Step::kFrequencyTransform, "freqt", num_input_order,
+            num_output_order);
+  step.alpha = alpha;
+  return step;
+}
+
+Step GeneralizedCepstrumTransformationStep(int num_input_order,
+                                           int num_output_order,
+                                           double input_gamma,
+                                           double output_gamma) {
+  Step step(Step::kGeneralizedCepstrumTransformation, "gc2gc",
+            num_input_order, num_output_order);
+  step.input_gamma = input_gamma;
+  step.output_gamma = output_gamma;
+  return step;
+}
+
+Step GammaDivisionStep(int num_order, double gamma) {
+  Step step(Step::kGammaDivision, "gamma division", num_order, num_order);
+  step.input_gamma = gamma;
+  step.output_gamma = gamma;
+  return step;
+}
+
+Step GammaMultiplicationStep(int num_order, double gamma) {
+  Step step(Step::kGammaMultiplication, "gamma multiplication", num_order,
+            num_order);
+  step.input_gamma = gamma;
+  step.output_gamma = gamma;
+  return step;
+}
+
+// Get the matrix of the step if the step is a linear map of a moderate size.
+bool GetLinearMap(const Step& step, sptk::Matrix* matrix) {
+  const int input_length(step.num_input_order + 1);
+  const int output_length(step.num_output_order + 1);
+  if (kMaxFusedMatrixSize / output_length < input_length) {
+    return false;
+  }
+
+  switch (step.kind) {
+    case Step::kLinearTransform: {
+      *matrix = step.matrix;
+      return true;
+    }
+    case Step::kFrequencyTransform: {
+      const sptk::FrequencyTransform frequency_transform(
+          step.num_input_order, step.num_output_order, step.alpha, true);
+      sptk::FrequencyTransform::Buffer buffer;
+      sptk::Matrix identity(input_length, input_length);
+      for (int i(0); i < input_length; ++i) {
+        identity[i][i] = 1.0;
+      }
+      return frequency_transform.Run(identity, matrix, &buffer);
+    }
+    case Step::kGeneralizedCepstrumTransformation: {
+      // With the same gamma, the transformation only copies the coefficients
+      // up to the input order. The coefficients beyond it are zero only if
+      // gamma is zero.
+      if (step.input_gamma != step.output_gamma ||
+          (0.0 != step.input_gamma &&
+           step.num_input_order < step.num_output_order)) {
+        return false;
+      }
+      matrix->Resize(input_length, output_length);
+      for (int i(0); i < input_length && i < output_length; ++i) {
+        (*matrix)[i][i] = 1.0;
+      }
+      return true;
+    }
+    case Step::kGammaDivision:
+    case Step::kGammaMultiplication: {
+      const double scale(Step::kGammaDivision == step.kind
+                             ? 1.0 / step.input_gamma
+                             : step.input_gamma);
+      matrix->Resize(input_length, output_length);
+      (*matrix)[0][0] = 1.0;
+      for (int i(1); i < input_length; ++i) {
+        (*matrix)[i][i] = scale;
+      }
+      return true;
+    }
+    default: {
+      break;
+    }
+  }
+  return false;
+}
+
+// Check whether the map keeps c[0] and does not mix it into the others.
+bool IsGainPreserved(const sptk::Matrix& matrix) {
+  if (1.0 != matrix[0][0]) return false;
+  for (int j(1); j < matrix.GetNumColumn(); ++j) {
+    if (0.0 != matrix[0][j]) return false;
+  }
+  for (int i(1); i < matrix.GetNumRow(); ++i) {
+    if (0.0 != matrix[i][0]) return false;
+  }
+  return true;
+}
+
+bool IsIdentity(const sptk::Matrix& matrix) {
+  if (matrix.GetNumRow() != matrix.GetNumColumn()) return false;
+  for (int i(0); i < matrix.GetNumRow(); ++i) {
+    for (int j(0); j < matrix.GetNumColumn(); ++j) {
+      if ((i == j ? 1.0 : 0.0) != matrix[i][j]) return false;
+    }
+  }
+  return true;
+}
+
+// Check whether the second step restores the input of the first one.
+bool IsInversePair(const Step& first, const Step& second) {
+  return first.input_gamma == second.input_gamma &&
+         ((Step::kGainNormalization == first.kind &&
+           Step::kInverseGainNormalization == second.kind) ||
+          (Step::kInverseGainNormalization == first.kind &&
+           Step::kGainNormalization == second.kind));
+}
+
+// Rewrite the steps until none of the following rules applies:
+//   A -> A^-1           =>  (removed)
+//   A -> L -> A^-1      =>  L, if L keeps c[0] and does not mix it
+//   L1 -> L2            =>  L1 * L2
+//   I                   =>  (removed)
+// where A is gain normalization or its inverse, and L is a linear map. The
+// second rule holds because the gain normalization only divides c[1], ...,
+// c[M] by a function of c[0].
+void OptimizeSteps(std::vector<Step>* steps) {
+  bool is_changed(true);
+  while (is_changed) {
+    is_changed = false;
+    const int num_steps(static_cast<int>(steps->size()));
+    for (int i(0); i < num_steps && !is_changed; ++i) {
+      const Step& step((*steps)[i]);
+      sptk::Matrix matrix;
+      if (i + 1 < num_steps && IsInversePair(step, (*steps)[i + 1])) {
+        steps->erase(steps->begin() + i, steps->begin() + i + 2);
+        is_changed = true;
+      } else if (i + 2 < num_steps && IsInversePair(step, (*steps)[i + 2]) &&
+                 GetLinearMap((*steps)[i + 1], &matrix) &&
+                 IsGainPreserved(matrix)) {
+        steps->erase(steps->begin() + i + 2);
+        steps->erase(steps->begin() + i);
+        is_changed = true;
+      } else if (GetLinearMap(step, &matrix)) {
+        sptk::Matrix next_matrix;
+        if (IsIdentity(matrix)) {
+          steps->erase(steps->begin() + i);
+          is_changed = true;
+        } else if (i + 1 < num_steps &&
+                   GetLinearMap((*steps)[i + 1], &next_matrix) &&
+                   kMaxFusedMatrixSize / next_matrix.GetNumColumn() >=
+                       matrix.GetNumRow()) {
+          const Step& next_step((*steps)[i + 1]);
+          Step fused(Step::kLinearTransform,
+                     step.name + " + " + next_step.name, step.num_input_order,
+                     next_step.num_output_order);
+          if (!matrix.Multiply(next_matrix, &fused.matrix)) continue;
+          (*steps)[i] = fused;
+          steps->erase(steps->begin() + i + 1);
+          is_changed = true;
+        }
+      }
+    }
+  }
+}
+
+std::string DescribeStep(const Step& step) {
+  std::ostringstream stream;
+  switch (step.kind) {
+    case Step::kLinearTransform: {
+      stream << "fused linear map (" << step.name << ")";
+      break;
+    }
+    case Step::kFrequencyTransform: {
+      stream << step.name << " (alpha = " << step.alpha << ")";
+      break;
+    }
+    case Step::kGeneralizedCepstrumTransformation: {
+      stream << step.name << " (gamma = " << step.input_gamma << " -> "
+             << step.output_gamma << ")";
+      break;
+    }
+    default: {
+      stream << step.name << " (gamma = " << step.input_gamma << ")";
+      break;
+    }
+  }
+  stream << ", order " << step.num_input_order << " -> "
+         << step.num_output_order;
+  return stream.str();
+}
+
+sptk::MelGeneralizedCepstrumToMelGeneralizedCepstrum::ModuleInterface*
+CreateModule(const Step& step) {
+  switch (step.kind) {
+    case Step::kGainNormalization: {
+      return new GainNormalizationModule(step.num_input_order,
+                                         step.input_gamma);
+    }
+    case Step::kInverseGainNormalization: {
+      return new InverseGainNormalizationModule(step.num_input_order,
+                                                step.input_gamma);
+    }
+    case Step::kFrequencyTransform: {
+      return new FrequencyTransformModule(step.num_input_order,
+                                          step.num_output_order, step.alpha);
+    }
+    case Step::kGeneralizedCepstrumTransformation: {
+      return new MelGeneralizedCepstrumToMelGeneralizedCepstrumModule(
+          step.num_input_order, step.num_output_order, step.input_gamma,
+          step.output_gamma);
+    }
+    case Step::kGammaDivision: {
+      return new GammaDivisionModule(step.num_input_order, step.input_gamma);
+    }
+    case Step::kGammaMultiplication: {
+      return new GammaMultiplicationModule(step.num_input_order,
+                                           step.input_gamma);
+    }
+    case Step::kLinearTransform: {
+      return new LinearTransformModule(step.matrix);
+    }
+    default: {
+      break;
+    }
+  }
+  return NULL;
+}
+
 }  // namespace
 
 namespace sptk {
@@ -359,62 +684,60 @@ MelGeneralizedCepstrumToMelGeneralizedCepstrum::
   // ch_a=T norm_i=T norm_o=T ch_g=T ch_m=T
   //   ignorm -> freqt -> gnorm -> gc2gc ->
 
+  std::vector<Step> steps;
   if (0.0 == alpha_transform_) {
     if (num_input_order_ == num_output_order_ &&
         input_gamma_ == output_gamma_) {
       if (!is_multiplied_input_ && is_multiplied_output_)
-        modules_.push_back(
-            new GammaMultiplicationModule(num_input_order_, input_gamma_));
+        steps.push_back(
+            GammaMultiplicationStep(num_input_order_, input_gamma_));
       if (!is_normalized_input_ && is_normalized_output_)
-        modules_.push_back(
-            new GainNormalizationModule(num_input_order_, input_gamma_));
+        steps.push_back(GainNormalizationStep(num_input_order_, input_gamma_));
       if (is_normalized_input_ && !is_normalized_output_)
-        modules_.push_back(new InverseGainNormalizationModule(num_output_order_,
-                                                              output_gamma_));
+        steps.push_back(
+            InverseGainNormalizationStep(num_output_order_, output_gamma_));
       if (is_multiplied_input_ && !is_multiplied_output_)
-        modules_.push_back(
-            new GammaDivisionModule(num_output_order_, output_gamma_));
+        steps.push_back(GammaDivisionStep(num_output_order_, output_gamma_));
     } else {
       if (is_multiplied_input_)
-        modules_.push_back(
-            new GammaDivisionModule(num_input_order_, input_gamma_));
+        steps.push_back(GammaDivisionStep(num_input_order_, input_gamma_));
       if (!is_normalized_input_)
-        modules_.push_back(
-            new GainNormalizationModule(num_input_order_, input_gamma_));
-      modules_.push_back(
-          new MelGeneralizedCepstrumToMelGeneralizedCepstrumModule(
-              num_input_order_, num_output_order_, input_gamma_,
-              output_gamma_));
+        steps.push_back(GainNormalizationStep(num_input_order_, input_gamma_));
+      steps.push_back(GeneralizedCepstrumTransformationStep(
+          num_input_order_, num_output_order_, input_gamma_, output_gamma_));
       if (!is_normalized_output_)
-        modules_.push_back(new InverseGainNormalizationModule(num_output_order_,
-                                                              output_gamma_));
+        steps.push_back(
+            InverseGainNormalizationStep(num_output_order_, output_gamma_));
       if (is_multiplied_output_)
-        modules_.push_back(
-            new GammaMultiplicationModule(num_output_order_, output_gamma_));
+        steps.push_back(
+            GammaMultiplicationStep(num_output_order_, output_gamma_));
     }
   } else {
     if (is_multiplied_input_)
-      modules_.push_back(
-          new GammaDivisionModule(num_input_order_, input_gamma_));
+      steps.push_back(GammaDivisionStep(num_input_order_, input_gamma_));
     if (is_normalized_input_)
-      modules_.push_back(
-          new InverseGainNormalizationModule(num_input_order_, input_gamma_));
-    modules_.push_back(new FrequencyTransformModule(
-        num_input_order_, num_output_order_, alpha_transform_));
+      steps.push_back(
+          InverseGainNormalizationStep(num_input_order_, input_gamma_));
+    steps.push_back(FrequencyTransformStep(num_input_order_, num_output_order_,
+                                           alpha_transform_));
     if (is_normalized_output_ || input_gamma_ != output_gamma_)
-      modules_.push_back(
-          new GainNormalizationModule(num_output_order_, input_gamma_));
+      steps.push_back(GainNormalizationStep(num_output_order_, input_gamma_));
     if (input_gamma_ != output_gamma_)
-      modules_.push_back(
-          new MelGeneralizedCepstrumToMelGeneralizedCepstrumModule(
-              num_output_order_, num_output_order_, input_gamma_,
-              output_gamma_));
+      steps.push_back(GeneralizedCepstrumTransformationStep(
+          num_output_order_, num_output_order_, input_gamma_, output_gamma_));
     if (!is_normalized_output_ && input_gamma_ != output_gamma_)
-      modules_.push_back(
-          new InverseGainNormalizationModule(num_output_order_, output_gamma_));
+      steps.push_back(
+          InverseGainNormalizationStep(num_output_order_, output_gamma_));
     if (is_multiplied_output_)
-      modules_.push_back(
-          new GammaMultiplicationModule(num_output_order_, output_gamma_));
+      steps.push_back(
+          GammaMultiplicationStep(num_output_order_, output_gamma_));
+  }
+
+  OptimizeSteps(&steps);
+  for (std::vector<Step>::const_iterator itr(steps.begin());
+       itr != steps.end(); ++itr) {
+    modules_.push_back(CreateModule(*itr));
+    plan_.push_back(DescribeStep(*itr));
   }
 
   for (std::vector<MelGeneralizedCepstrumToMelGeneralizedCepstrum::
@@ -52,7 +52,7 @@ MelGeneralizedCepstrumToSpectrum::MelGeneralizedCepstrumToSpectrum(
     : mel_generalized_cepstrum_transform_(
           num_order, alpha, gamma, is_normalized, is_multiplied, fft_length / 2,
           0.0, 0.0, false, false),
-      fast_fourier_transform_(fft_length / 2, fft_length),
+      fast_fourier_transform_(fft_length / 2, fft_length, true),
       is_valid_(true) {
   if (!mel_generalized_cepstrum_transform_.IsValid() ||
       !fast_fourier_transform_.IsValid()) {
@@ -86,11 +86,7 @@ bool MglsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // prepare memories
-  if (buffer->signals_.size() !=
-      static_cast<std::size_t>((num_filter_order_ + 1) * num_stage_)) {
-    buffer->signals_.resize((num_filter_order_ + 1) * num_stage_);
-    std::fill(buffer->signals_.begin(), buffer->signals_.end(), 0.0);
-  }
+  PrepareBuffer(buffer);
 
   const double gained_input(filter_input * std::exp(filter_coefficients[0]));
   if (0 == num_filter_order_) {
@@ -98,41 +94,136 @@ bool MglsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     return true;
   }
 
+  *filter_output = RunSample(&(filter_coefficients[1]), gained_input, buffer);
+
+  return true;
+}
+
+bool MglsaDigitalFilter::RunBlock(
+    const std::vector<double>& filter_coefficients, const double* filter_input,
+    double* filter_output, int num_samples,
+    MglsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_input || NULL == filter_output || num_samples < 0 ||
+      NULL == buffer) {
+    return false;
+  }
+
+  if (0 == num_stage_) {
+    return mlsa_digital_filter_.RunBlock(
+        filter_coefficients, filter_input, filter_output, num_samples,
+        &(buffer->mlsa_digital_filter_buffer_));
+  }
+
+  // prepare memories
+  PrepareBuffer(buffer);
+
+  const double gain(std::exp(filter_coefficients[0]));
+  if (0 == num_filter_order_) {
+    for (int t(0); t < num_samples; ++t) {
+      filter_output[t] = filter_input[t] * gain;
+    }
+    return true;
+  }
+
   const double* b(&(filter_coefficients[1]));
-  const double beta(1.0 - alpha_ * alpha_);
+  for (int t(0); t < num_samples; ++t) {
+    filter_output[t] = RunSample(b, filter_input[t] * gain, buffer);
+  }
+
+  return true;
+}
+
+bool MglsaDigitalFilter::RunBlock(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& increments_of_filter_coefficients,
+    const double* filter_input, double* filter_output, int num_samples,
+    MglsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      increments_of_filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_input || NULL == filter_output || num_samples < 0 ||
+      NULL == buffer) {
+    return false;
+  }
+
+  if (0 == num_stage_) {
+    return mlsa_digital_filter_.RunBlock(
+        filter_coefficients, increments_of_filter_coefficients, filter_input,
+        filter_output, num_samples, &(buffer->mlsa_digital_filter_buffer_));
+  }
+
+  // prepare memories
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = filter_coefficients;
+
+  double* b(&(buffer->interpolated_filter_coefficients_[0]));
+  const double* db(&(increments_of_filter_coefficients[0]));
+  for (int t(0); t < num_samples; ++t) {
+    const double gained_input(filter_input[t] * std::exp(b[0]));
+    filter_output[t] = (0 == num_filter_order_)
+                           ? gained_input
+                           : RunSample(b + 1, gained_input, buffer);
+    for (int m(0); m <= num_filter_order_; ++m) {
+      b[m] += db[m];
+    }
+  }
+
+  return true;
+}
+
+void MglsaDigitalFilter::PrepareBuffer(
+    MglsaDigitalFilter::Buffer* buffer) const {
+  if (buffer->signals_.size() !=
+      static_cast<std::size_t>((num_filter_order_ + 1) * num_stage_)) {
+    buffer->signals_.resize((num_filter_order_ + 1) * num_stage_);
+    std::fill(buffer->signals_.begin(), buffer->signals_.end(), 0.0);
+  }
+}
+
+double MglsaDigitalFilter::RunSample(const double* b, double gained_input,
+                                     MglsaDigitalFilter::Buffer* buffer) const {
+  // Copy members to local variables so that they can stay in registers
+  // throughout the cascade.
+  const int m(num_filter_order_);
+  const double alpha(alpha_);
+  const double beta(1.0 - alpha * alpha);
   double x(gained_input);
 
-  for (int i(0); i < num_stage_; ++i) {
-    double* d(&buffer->signals_[(num_filter_order_ + 1) * i]);
+  double* d(&buffer->signals_[0]);
+  for (int i(0); i < num_stage_; ++i, d += m + 1) {
     if (transposition_) {
       x -= beta * d[0];
-      d[num_filter_order_] =
-          b[num_filter_order_ - 1] * x + alpha_ * d[num_filter_order_ - 1];
-      for (int j(num_filter_order_ - 1); 0 < j; --j) {
-        d[j] += b[j - 1] * x + alpha_ * (d[j - 1] - d[j + 1]);
+      d[m] = b[m - 1] * x + alpha * d[m - 1];
+      for (int j(m - 1); 0 < j; --j) {
+        d[j] += b[j - 1] * x + alpha * (d[j - 1] - d[j + 1]);
       }
 
-      for (int j(0); j < num_filter_order_; ++j) {
+      for (int j(0); j < m; ++j) {
         d[j] = d[j + 1];
       }
     } else {
       double y(d[0] * b[0]);
-      for (int j(1); j < num_filter_order_; ++j) {
-        d[j] += alpha_ * (d[j + 1] - d[j - 1]);
+      for (int j(1); j < m; ++j) {
+        d[j] += alpha * (d[j + 1] - d[j - 1]);
         y += d[j] * b[j];
       }
       x -= y;
 
-      for (int j(num_filter_order_); 0 < j; --j) {
+      for (int j(m); 0 < j; --j) {
         d[j] = d[j - 1];
       }
-      d[0] = alpha_ * d[0] + beta * x;
+      d[0] = alpha * d[0] + beta * x;
     }
   }
 
-  *filter_output = x;
-
-  return true;
+  return x;
 }
 
 }  // namespace sptk
@@ -117,6 +117,88 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   }
 
   // prepare memories
+  PrepareBuffer(buffer);
+
+  // set value
+  const double gained_input(filter_input * std::exp(filter_coefficients[0]));
+  if (0 == num_filter_order_) {
+    *filter_output = gained_input;
+    return true;
+  }
+
+  *filter_output = RunSample(&(filter_coefficients[0]), gained_input, buffer);
+
+  return true;
+}
+
+bool MlsaDigitalFilter::RunBlock(const std::vector<double>& filter_coefficients,
+                                 const double* filter_input,
+                                 double* filter_output, int num_samples,
+                                 MlsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_input || NULL == filter_output || num_samples < 0 ||
+      NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  PrepareBuffer(buffer);
+
+  const double gain(std::exp(filter_coefficients[0]));
+  if (0 == num_filter_order_) {
+    for (int t(0); t < num_samples; ++t) {
+      filter_output[t] = filter_input[t] * gain;
+    }
+    return true;
+  }
+
+  const double* b(&(filter_coefficients[0]));
+  for (int t(0); t < num_samples; ++t) {
+    filter_output[t] = RunSample(b, filter_input[t] * gain, buffer);
+  }
+
+  return true;
+}
+
+bool MlsaDigitalFilter::RunBlock(
+    const std::vector<double>& filter_coefficients,
+    const std::vector<double>& increments_of_filter_coefficients,
+    const double* filter_input, double* filter_output, int num_samples,
+    MlsaDigitalFilter::Buffer* buffer) const {
+  // check inputs
+  if (!is_valid_ ||
+      filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      increments_of_filter_coefficients.size() !=
+          static_cast<std::size_t>(num_filter_order_ + 1) ||
+      NULL == filter_input || NULL == filter_output || num_samples < 0 ||
+      NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  PrepareBuffer(buffer);
+  buffer->interpolated_filter_coefficients_ = filter_coefficients;
+
+  double* b(&(buffer->interpolated_filter_coefficients_[0]));
+  const double* db(&(increments_of_filter_coefficients[0]));
+  for (int t(0); t < num_samples; ++t) {
+    const double gained_input(filter_input[t] * std::exp(b[0]));
+    filter_output[t] = (0 == num_filter_order_)
+                           ? gained_input
+                           : RunSample(b, gained_input, buffer);
+    for (int m(0); m <= num_filter_order_; ++m) {
+      b[m] += db[m];
+    }
+  }
+
+  return true;
+}
+
+void MlsaDigitalFilter::PrepareBuffer(MlsaDigitalFilter::Buffer* buffer) const {
   if (buffer->signals_for_basic_filter1_.size() !=
       static_cast<std::size_t>(num_pade_order_ + 1)) {
     buffer->signals_for_basic_filter1_.resize(num_pade_order_ + 1);
@@ -142,28 +224,30 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     std::fill(buffer->signals_for_exp_filter2_.begin(),
               buffer->signals_for_exp_filter2_.end(), 0.0);
   }
+}
 
-  // set value
-  const double gained_input(filter_input * std::exp(filter_coefficients[0]));
-  if (0 == num_filter_order_) {
-    *filter_output = gained_input;
-    return true;
-  }
-
-  const double* b(&(filter_coefficients[0]));
-  const double beta(1.0 - alpha_ * alpha_);
+double MlsaDigitalFilter::RunSample(const double* b, double gained_input,
+                                    MlsaDigitalFilter::Buffer* buffer) const {
+  // Copy members to local variables so that they can stay in registers
+  // throughout the Pade cascade.
+  const int m(num_filter_order_);
+  const double alpha(alpha_);
+  const double beta(1.0 - alpha * alpha);
+  const double* pade(&(pade_coefficients_[0]));
 
   // First stage
   double first_output(0.0);
   {
     double* d1(&buffer->signals_for_basic_filter1_[0]);
     double* p1(&buffer->signals_for_exp_filter1_[0]);
+    const double b1(b[1]);
     double x(gained_input);
     for (int i(num_pade_order_); 0 < i; --i) {
-      d1[i] = beta * p1[i - 1] + alpha_ * d1[i];
-      p1[i] = d1[i] * b[1];
+      const double d(beta * p1[i - 1] + alpha * d1[i]);
+      d1[i] = d;
+      p1[i] = d * b1;
 
-      const double v(p1[i] * pade_coefficients_[i]);
+      const double v(p1[i] * pade[i]);
       x += (i % 2 == 1) ? v : -v;
       first_output += v;
     }
@@ -175,37 +259,37 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
   double second_output(0.0);
   {
     double* p2(&buffer->signals_for_exp_filter2_[0]);
+    double* d2(&buffer->signals_for_basic_filter2_[0]);
     double x(first_output);
     for (int i(num_pade_order_); 0 < i; --i) {
-      const int bias((i - 1) * (num_filter_order_ + 2));
-      double* d2(&buffer->signals_for_basic_filter2_[bias]);
+      double* d(d2 + (i - 1) * (m + 2));
+      const double u(p2[i - 1]);
 
       if (transposition_) {
-        d2[num_filter_order_] = b[num_filter_order_] * p2[i - 1] +
-                                alpha_ * d2[num_filter_order_ - 1];
-        for (int j(num_filter_order_ - 1); 1 < j; --j) {
-          d2[j] += b[j] * p2[i - 1] + alpha_ * (d2[j - 1] - d2[j + 1]);
+        d[m] = b[m] * u + alpha * d[m - 1];
+        for (int j(m - 1); 1 < j; --j) {
+          d[j] += b[j] * u + alpha * (d[j - 1] - d[j + 1]);
         }
-        d2[1] += alpha_ * (d2[0] - d2[2]);
-        p2[i] = beta * d2[0];
-        for (int j(0); j < num_filter_order_; ++j) {
-          d2[j] = d2[j + 1];
+        d[1] += alpha * (d[0] - d[2]);
+        p2[i] = beta * d[0];
+        for (int j(0); j < m; ++j) {
+          d[j] = d[j + 1];
         }
       } else {
-        d2[0] = p2[i - 1];
-        d2[1] = beta * p2[i - 1] + alpha_ * d2[1];
+        d[0] = u;
+        d[1] = beta * u + alpha * d[1];
         double y(0.0);
-        for (int j(2); j <= num_filter_order_; ++j) {
-          d2[j] += alpha_ * (d2[j + 1] - d2[j - 1]);
-          y += d2[j] * b[j];
+        for (int j(2); j <= m; ++j) {
+          d[j] += alpha * (d[j + 1] - d[j - 1]);
+          y += d[j] * b[j];
         }
         p2[i] = y;
-        for (int j(num_filter_order_ + 1); 1 < j; --j) {
-          d2[j] = d2[j - 1];
+        for (int j(m + 1); 1 < j; --j) {
+          d[j] = d[j - 1];
         }
       }
 
-      const double v(p2[i] * pade_coefficients_[i]);
+      const double v(p2[i] * pade[i]);
       x += (i % 2 == 1) ? v : -v;
       second_output += v;
     }
@@ -213,9 +297,7 @@ bool MlsaDigitalFilter::Run(const std::vector<double>& filter_coefficients,
     second_output += x;
   }
 
-  *filter_output = second_output;
-
-  return true;
+  return second_output;
 }
 
 }  // namespace sptk
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include "SPTK/input/input_source_from_mapped_file.h"
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // madvise, mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#include <algorithm>   // std::copy, std::fill
+#include <cstring>     // std::memcpy
+
+namespace sptk {
+
+InputSourceFromMappedFile::InputSourceFromMappedFile(bool zero_padding,
+                                                     int stream_skip,
+                                                     int read_size,
+                                                     const char* file_name)
+    : zero_padding_(zero_padding),
+      stream_skip_(stream_skip),
+      read_size_(read_size),
+      mapped_data_(NULL),
+      mapped_size_(0),
+      position_(0),
+      is_valid_(true) {
+  if (stream_skip_ < 0 || read_size_ <= 0 || NULL == file_name) {
+    is_valid_ = false;
+    return;
+  }
+
+  const int file_descriptor(open(file_name, O_RDONLY));
+  if (file_descriptor < 0) {
+    is_valid_ = false;
+    return;
+  }
+
+  // Pipes and devices cannot be mapped, so leave them to stream input.
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) < 0 ||
+      !S_ISREG(file_status.st_mode)) {
+    close(file_descriptor);
+    is_valid_ = false;
+    return;
+  }
+
+  mapped_size_ = static_cast<std::size_t>(file_status.st_size);
+  if (0 < mapped_size_) {
+    mapped_data_ =
+        mmap(NULL, mapped_size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (MAP_FAILED == mapped_data_) {
+      mapped_data_ = NULL;
+      mapped_size_ = 0;
+      is_valid_ = false;
+    } else {
+      // Let the kernel read ahead aggressively and drop pages already read.
+      madvise(mapped_data_, mapped_size_, MADV_SEQUENTIAL);
+    }
+  }
+  close(file_descriptor);
+}
+
+InputSourceFromMappedFile::~InputSourceFromMappedFile() {
+  if (NULL != mapped_data_) {
+    munmap(mapped_data_, mapped_size_);
+  }
+}
+
+bool InputSourceFromMappedFile::Get(std::vector<double>* buffer) {
+  if (NULL == buffer) {
+    return false;
+  }
+
+  const double* frame;
+  if (!Get(&frame, NULL)) {
+    return false;
+  }
+
+  if (buffer->size() < static_cast<std::size_t>(read_size_)) {
+    buffer->resize(read_size_);
+  }
+  std::copy(frame, frame + read_size_, buffer->begin());
+
+  return true;
+}
+
+bool InputSourceFromMappedFile::Get(const double** frame,
+                                    int* actual_read_size) {
+  if (NULL == frame || !is_valid_ || mapped_size_ <= position_) {
+    return false;
+  }
+
+  const std::size_t type_byte(sizeof(double));
+  const std::size_t num_skip_bytes(type_byte * stream_skip_);
+  if (mapped_size_ - position_ <= num_skip_bytes) {
+    position_ = mapped_size_;
+    return false;
+  }
+  position_ += num_skip_bytes;
+
+  const char* head(static_cast<const char*>(mapped_data_) + position_);
+  const std::size_t num_read_bytes(type_byte * read_size_);
+  const std::size_t num_remaining_bytes(mapped_size_ - position_);
+
+  if (num_read_bytes <= num_remaining_bytes) {
+    if (NULL != actual_read_size) {
+      *actual_read_size = read_size_;
+    }
+    // The mapping is page-aligned and the position advances by whole
+    // elements, so the frame is always aligned and can be used in place.
+    *frame = reinterpret_cast<const double*>(head);
+    position_ += num_read_bytes;
+    return true;
+  }
+
+  // The last frame is incomplete.
+  const int num_elements(num_remaining_bytes / type_byte);
+  if (NULL != actual_read_size) {
+    *actual_read_size = num_elements;
+  }
+  position_ = mapped_size_;
+  if (!zero_padding_) {
+    return false;
+  }
+
+  padded_frame_.resize(read_size_);
+  std::memcpy(&(padded_frame_[0]), head, type_byte * num_elements);
+  std::fill(padded_frame_.begin() + num_elements, padded_frame_.end(), 0.0);
+  *frame = &(padded_frame_[0]);
+
+  return true;
+}
+
+}  // namespace sptk
@@ -44,7 +44,7 @@
 
 #include "SPTK/input/input_source_interpolation.h"
 
-#include <algorithm>   // std::copy, std::transform
+#include <algorithm>   // std::copy, std::fill, std::transform
 #include <cstddef>     // std::size_t
 #include <functional>  // std::plus
 
@@ -111,6 +111,49 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
 
   std::copy(curr_data_.begin(), curr_data_.end(), buffer->begin());
 
+  Update();
+
+  return true;
+}
+
+bool InputSourceInterpolation::Get(int max_num_samples,
+                                   std::vector<double>* buffer,
+                                   std::vector<double>* increment,
+                                   int* num_samples) {
+  if (max_num_samples <= 0 || NULL == buffer || NULL == increment ||
+      NULL == num_samples || !is_valid_) {
+    return false;
+  }
+
+  if (remained_num_samples_ <= 0) {
+    return false;
+  }
+
+  if (buffer->size() != static_cast<std::size_t>(data_length_)) {
+    buffer->resize(data_length_);
+  }
+  if (increment->size() != static_cast<std::size_t>(data_length_)) {
+    increment->resize(data_length_);
+  }
+
+  std::copy(curr_data_.begin(), curr_data_.end(), buffer->begin());
+  if (1 == interpolation_period_) {
+    std::copy(increment_.begin(), increment_.end(), increment->begin());
+  } else {
+    std::fill(increment->begin(), increment->end(), 0.0);
+  }
+
+  // Extend the run until the data change in another way.
+  *num_samples = 0;
+  do {
+    ++(*num_samples);
+  } while (Update() && *num_samples < max_num_samples &&
+           0 < remained_num_samples_);
+
+  return true;
+}
+
+bool InputSourceInterpolation::Update() {
   --remained_num_samples_;
 
   if (remained_num_samples_ <= 0) {
@@ -120,7 +163,6 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
     return true;
   }
 
-  // Update internal states for the next call.
   ++point_index_in_frame_;
 
   if (0 == point_index_in_frame_ % frame_period_) {
@@ -140,15 +182,18 @@ bool InputSourceInterpolation::Get(std::vector<double>* buffer) {
 
     // Rewind point index.
     point_index_in_frame_ = 0;
+    return false;
   } else if (0 < interpolation_period_ &&
              0 == ((point_index_in_frame_ + first_interpolation_period_) %
                    interpolation_period_)) {
     // Interpolate adjacent data.
     std::transform(curr_data_.begin(), curr_data_.end(), increment_.begin(),
                    curr_data_.begin(), std::plus<double>());
+    return 1 == interpolation_period_;
   } else if (0 == interpolation_period_ &&
              frame_period_ / 2 == point_index_in_frame_) {
     std::copy(next_data_.begin(), next_data_.end(), curr_data_.begin());
+    return false;
   }
 
   return true;
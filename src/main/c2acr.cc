@@ -50,6 +50,7 @@
 #include <vector>
 
 #include "SPTK/converter/cepstrum_to_autocorrelation.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -57,6 +58,7 @@ namespace {
 const int kDefaultNumInputOrder(25);
 const int kDefaultNumOutputOrder(25);
 const int kDefaultFftLength(256);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -69,6 +71,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -m m  : order of cepstrum        (   int)[" << std::setw(5) << std::right << kDefaultNumInputOrder  << "][ 0 <= m <  l ]" << std::endl;  // NOLINT
   *stream << "       -M M  : order of autocorrelation (   int)[" << std::setw(5) << std::right << kDefaultNumOutputOrder << "][ 0 <= M <  l ]" << std::endl;  // NOLINT
   *stream << "       -l l  : FFT length               (   int)[" << std::setw(5) << std::right << kDefaultFftLength      << "][ 2 <= l <=   ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads        (   int)[" << std::setw(5) << std::right << kDefaultNumThread      << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       cepstrum                         (double)[stdin]" << std::endl;  // NOLINT
@@ -86,9 +89,10 @@ int main(int argc, char* argv[]) {
   int num_input_order(kDefaultNumInputOrder);
   int num_output_order(kDefaultNumOutputOrder);
   int fft_length(kDefaultFftLength);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const char option_char(getopt_long(argc, argv, "m:M:l:h", NULL, NULL));
+    const char option_char(getopt_long(argc, argv, "m:M:l:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -123,6 +127,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("c2acr", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -166,7 +181,7 @@ int main(int argc, char* argv[]) {
 
   sptk::CepstrumToAutocorrelation cepstrum_to_autocorrelation(
       num_input_order, num_output_order, fft_length);
-  sptk::CepstrumToAutocorrelation::Buffer buffer;
+  std::vector<sptk::CepstrumToAutocorrelation::Buffer> buffers(num_thread);
   if (!cepstrum_to_autocorrelation.IsValid()) {
     std::ostringstream error_message;
     error_message << "FFT length must be a power of 2 and greater than 1";
@@ -176,25 +191,31 @@ int main(int argc, char* argv[]) {
 
   const int input_length(num_input_order + 1);
   const int output_length(num_output_order + 1);
-  std::vector<double> cepstrum(input_length);
-  std::vector<double> autocorrelation(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &cepstrum, &input_stream,
-                          NULL)) {
-    if (!cepstrum_to_autocorrelation.Run(cepstrum, &autocorrelation, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to transform cepstrum to autocorrelation";
-      sptk::PrintErrorMessage("c2acr", error_message);
-      return 1;
-    }
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, output_length, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("c2acr", error_message);
+    return 1;
+  }
 
-    if (!sptk::WriteStream(0, output_length, autocorrelation, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write autocorrelation sequence";
-      sptk::PrintErrorMessage("c2acr", error_message);
-      return 1;
-    }
+  if (!parallel_frame_processing.Run(
+          [&cepstrum_to_autocorrelation, &buffers](
+              const std::vector<double>& cepstrum,
+              std::vector<double>* autocorrelation, int thread_index) {
+            return cepstrum_to_autocorrelation.Run(cepstrum, autocorrelation,
+                                                   &buffers[thread_index]);
+          },
+          [output_length](const std::vector<double>& autocorrelation) {
+            return sptk::WriteStream(0, output_length, autocorrelation,
+                                     &std::cout, NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to transform cepstrum to autocorrelation";
+    sptk::PrintErrorMessage("c2acr", error_message);
+    return 1;
   }
 
   return 0;
@@ -253,7 +253,9 @@ int main(int argc, char* argv[]) {
     }
 
     double filter_input, filter_output;
-    while (sptk::ReadStream(&filter_input, &input_stream)) {
+    sptk::BufferedStreamReader reader(&input_stream);
+    sptk::BufferedStreamWriter writer(&std::cout);
+    while (reader.Read(&filter_input)) {
       for (int i(0); i < num_filter; ++i) {
         if (!filters[i]->Run(filter_input, &filter_output, &buffers[i])) {
           std::ostringstream error_message;
@@ -264,13 +266,20 @@ int main(int argc, char* argv[]) {
         filter_input = filter_output;
       }
 
-      if (!sptk::WriteStream(filter_output, &std::cout)) {
+      if (!writer.Write(filter_output)) {
         std::ostringstream error_message;
         error_message << "Failed to write a filter output";
         sptk::PrintErrorMessage("df2", error_message);
         throw;
       }
     }
+
+    if (!writer.Flush()) {
+      std::ostringstream error_message;
+      error_message << "Failed to write a filter output";
+      sptk::PrintErrorMessage("df2", error_message);
+      throw;
+    }
   } catch (...) {
     for (sptk::InfiniteImpulseResponseDigitalFilter* filter : filters) {
       delete filter;
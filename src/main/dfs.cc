@@ -230,7 +230,9 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  while (sptk::ReadStream(&filter_input, &input_stream)) {
+  sptk::BufferedStreamReader reader(&input_stream);
+  sptk::BufferedStreamWriter writer(&std::cout);
+  while (reader.Read(&filter_input)) {
     if (!filter.Run(filter_input, &filter_output, &buffer)) {
       std::ostringstream error_message;
       error_message << "Failed to apply digital filter";
@@ -238,7 +240,7 @@ int main(int argc, char* argv[]) {
       return 1;
     }
 
-    if (!sptk::WriteStream(filter_output, &std::cout)) {
+    if (!writer.Write(filter_output)) {
       std::ostringstream error_message;
       error_message << "Failed to write a filter output";
       sptk::PrintErrorMessage("dfs", error_message);
@@ -246,5 +248,12 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (!writer.Flush()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write a filter output";
+    sptk::PrintErrorMessage("dfs", error_message);
+    return 1;
+  }
+
   return 0;
 }
@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -110,14 +111,20 @@ class DataDump : public DataDumpInterface {
   }
 
   virtual bool Run(std::istream* input_stream) const {
+    char index_buffer[kBufferSize];
     char buffer[kBufferSize];
     T data;
-    for (int index(minimum_index_); sptk::ReadStream(&data, input_stream);
-         ++index) {
+    sptk::BufferedStreamReader reader(input_stream);
+    sptk::BufferedStreamWriter writer(&std::cout);
+    for (int index(minimum_index_); reader.Read(&data); ++index) {
+      std::snprintf(index_buffer, sizeof(index_buffer), "%d\t", index);
       if (!sptk::SnPrintf(data, print_format_, sizeof(buffer), buffer)) {
         return false;
       }
-      std::cout << index << '\t' << buffer << std::endl;
+      if (!writer.WriteString(index_buffer) || !writer.WriteString(buffer) ||
+          !writer.Write('\n')) {
+        return false;
+      }
 
       if (maximum_index_ != kMagicNumberForEndOfFile &&
           maximum_index_ == index) {
@@ -125,7 +132,7 @@ class DataDump : public DataDumpInterface {
       }
     }
 
-    return true;
+    return writer.Flush();
   }
 
  private:
@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <cstddef>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -50,6 +51,8 @@
 #include <utility>
 #include <vector>
 
+#include "SPTK/input/input_source_from_mapped_file.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/math/distance_calculator.h"
 #include "SPTK/math/dynamic_time_warping.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -62,6 +65,7 @@ const sptk::DynamicTimeWarping::LocalPathConstraints
         sptk::DynamicTimeWarping::LocalPathConstraints::kType5);
 const sptk::DistanceCalculator::DistanceMetrics kDefaultDistanceMetric(
     sptk::DistanceCalculator::DistanceMetrics::kSquaredEuclidean);
+const bool kDefaultScoreOnlyFlag(false);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -79,6 +83,12 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (Euclidean)" << std::endl;
   *stream << "                 2 (squared Euclidean)" << std::endl;
   *stream << "                 3 (symmetric Kullback-Leibler)" << std::endl;
+  *stream << "       -b b  : width of Sakoe-Chiba band      (   int)[" << std::setw(5) << std::right << "N/A"                       << "][ 0 <= b <=   ]" << std::endl;  // NOLINT
+  *stream << "       -s s  : maximum slope of Itakura       (double)[" << std::setw(5) << std::right << "N/A"                       << "][ 1 <= s <=   ]" << std::endl;  // NOLINT
+  *stream << "               parallelogram" << std::endl;
+  *stream << "       -M M  : maximum memory for back        (   int)[" << std::setw(5) << std::right << "N/A"                       << "][ 0 <  M <=   ]" << std::endl;  // NOLINT
+  *stream << "               pointers [MB]" << std::endl;
+  *stream << "       -o    : output only total score        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultScoreOnlyFlag) << "]" << std::endl;  // NOLINT
   *stream << "       -P P  : output filename of int type    (string)[" << std::setw(5) << std::right << "N/A"                       << "]" << std::endl;  // NOLINT
   *stream << "               Viterbi path" << std::endl;
   *stream << "       -S S  : output filename of double type (string)[" << std::setw(5) << std::right << "N/A"                       << "]" << std::endl;  // NOLINT
@@ -89,7 +99,11 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  infile:" << std::endl;
   *stream << "       query vector sequence                  (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
-  *stream << "       warped vector sequence                 (double)" << std::endl;  // NOLINT
+  *stream << "       warped vector sequence or total score  (double)" << std::endl;  // NOLINT
+  *stream << "  notice:" << std::endl;
+  *stream << "       -b and -s options are exclusive" << std::endl;
+  *stream << "       if -o option is given, -P option is ignored" << std::endl;  // NOLINT
+  *stream << "       if back pointers need more than M megabytes, Viterbi path is found by divide and conquer" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -104,11 +118,17 @@ int main(int argc, char* argv[]) {
       kDefaultLocalPathConstraint);
   sptk::DistanceCalculator::DistanceMetrics distance_metric(
       kDefaultDistanceMetric);
+  sptk::DynamicTimeWarping::GlobalPathConstraints global_path_constraint(
+      sptk::DynamicTimeWarping::GlobalPathConstraints::kNone);
+  double global_path_constraint_parameter(0.0);
+  int maximum_memory_size_in_megabytes(0);
+  bool score_only_flag(kDefaultScoreOnlyFlag);
   const char* total_score_file(NULL);
   const char* viterbi_path_file(NULL);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:p:d:P:S:h", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:p:d:b:s:M:oP:S:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -173,6 +193,64 @@ int main(int argc, char* argv[]) {
             static_cast<sptk::DistanceCalculator::DistanceMetrics>(tmp);
         break;
       }
+      case 'b': {
+        int tmp;
+        if (!sptk::ConvertStringToInteger(optarg, &tmp) || tmp < 0) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -b option must be a "
+                        << "non-negative integer";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        if (sptk::DynamicTimeWarping::GlobalPathConstraints::
+                kItakuraParallelogram == global_path_constraint) {
+          std::ostringstream error_message;
+          error_message << "Cannot specify -b option with -s option";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        global_path_constraint =
+            sptk::DynamicTimeWarping::GlobalPathConstraints::kSakoeChibaBand;
+        global_path_constraint_parameter = tmp;
+        break;
+      }
+      case 's': {
+        if (!sptk::ConvertStringToDouble(optarg,
+                                         &global_path_constraint_parameter) ||
+            global_path_constraint_parameter < 1.0) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -s option must be a number "
+                        << "equal to or greater than 1";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        if (sptk::DynamicTimeWarping::GlobalPathConstraints::kSakoeChibaBand ==
+            global_path_constraint) {
+          std::ostringstream error_message;
+          error_message << "Cannot specify -s option with -b option";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        global_path_constraint = sptk::DynamicTimeWarping::
+            GlobalPathConstraints::kItakuraParallelogram;
+        break;
+      }
+      case 'M': {
+        if (!sptk::ConvertStringToInteger(optarg,
+                                          &maximum_memory_size_in_megabytes) ||
+            maximum_memory_size_in_megabytes <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -M option must be a positive integer";
+          sptk::PrintErrorMessage("dtw", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'o': {
+        score_only_flag = true;
+        break;
+      }
       case 'P': {
         viterbi_path_file = optarg;
         break;
@@ -213,36 +291,54 @@ int main(int argc, char* argv[]) {
 
   std::vector<std::vector<double> > reference_vectors;
   {
+    sptk::InputSourceFromMappedFile input_source_from_file(false, 0, length,
+                                                           reference_file);
     std::ifstream ifs;
-    ifs.open(reference_file, std::ios::in | std::ios::binary);
-    if (ifs.fail()) {
-      std::ostringstream error_message;
-      error_message << "Cannot open file " << reference_file;
-      sptk::PrintErrorMessage("dtw", error_message);
-      return 1;
+    if (!input_source_from_file.IsValid()) {
+      ifs.open(reference_file, std::ios::in | std::ios::binary);
+      if (ifs.fail()) {
+        std::ostringstream error_message;
+        error_message << "Cannot open file " << reference_file;
+        sptk::PrintErrorMessage("dtw", error_message);
+        return 1;
+      }
     }
-    std::istream& input_stream(ifs);
+    sptk::InputSourceFromStream input_source_from_stream(false, length, &ifs);
+    sptk::InputSourceInterface& input_source(
+        input_source_from_file.IsValid()
+            ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+            : input_source_from_stream);
 
     std::vector<double> tmp(length);
-    while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
+    while (input_source.Get(&tmp)) {
       reference_vectors.push_back(tmp);
     }
   }
 
   std::vector<std::vector<double> > query_vectors;
   {
+    sptk::InputSourceFromMappedFile input_source_from_file(false, 0, length,
+                                                           query_file);
     std::ifstream ifs;
-    ifs.open(query_file, std::ios::in | std::ios::binary);
-    if (ifs.fail() && NULL != query_file) {
-      std::ostringstream error_message;
-      error_message << "Cannot open file " << query_file;
-      sptk::PrintErrorMessage("dtw", error_message);
-      return 1;
+    if (!input_source_from_file.IsValid()) {
+      ifs.open(query_file, std::ios::in | std::ios::binary);
+      if (ifs.fail() && NULL != query_file) {
+        std::ostringstream error_message;
+        error_message << "Cannot open file " << query_file;
+        sptk::PrintErrorMessage("dtw", error_message);
+        return 1;
+      }
     }
-    std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+    std::istream& input_stream(ifs.is_open() ? ifs : std::cin);
+    sptk::InputSourceFromStream input_source_from_stream(false, length,
+                                                         &input_stream);
+    sptk::InputSourceInterface& input_source(
+        input_source_from_file.IsValid()
+            ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+            : input_source_from_stream);
 
     std::vector<double> tmp(length);
-    while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
+    while (input_source.Get(&tmp)) {
       query_vectors.push_back(tmp);
     }
   }
@@ -260,7 +356,7 @@ int main(int argc, char* argv[]) {
   std::ostream& output_stream_for_score(ofs1);
 
   std::ofstream ofs2;
-  if (NULL != viterbi_path_file) {
+  if (NULL != viterbi_path_file && !score_only_flag) {
     ofs2.open(viterbi_path_file, std::ios::out | std::ios::binary);
     if (ofs2.fail()) {
       std::ostringstream error_message;
@@ -272,7 +368,10 @@ int main(int argc, char* argv[]) {
   std::ostream& output_stream_for_path(ofs2);
 
   sptk::DynamicTimeWarping dynamic_time_warping(
-      num_order, local_path_constraint, distance_metric);
+      num_order, local_path_constraint, distance_metric,
+      global_path_constraint, global_path_constraint_parameter,
+      static_cast<std::size_t>(maximum_memory_size_in_megabytes) * 1024 *
+          1024);
   if (!dynamic_time_warping.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition for dynamic time warping";
@@ -282,7 +381,8 @@ int main(int argc, char* argv[]) {
 
   std::vector<std::pair<int, int> > viterbi_path;
   double total_score;
-  if (!dynamic_time_warping.Run(query_vectors, reference_vectors, &viterbi_path,
+  if (!dynamic_time_warping.Run(query_vectors, reference_vectors,
+                                score_only_flag ? NULL : &viterbi_path,
                                 &total_score)) {
     std::ostringstream error_message;
     error_message << "Failed to run dynamic time warping";
@@ -290,6 +390,18 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  if (score_only_flag) {
+    if (!sptk::WriteStream(total_score, &std::cout) ||
+        (NULL != total_score_file &&
+         !sptk::WriteStream(total_score, &output_stream_for_score))) {
+      std::ostringstream error_message;
+      error_message << "Failed to write total score";
+      sptk::PrintErrorMessage("dtw", error_message);
+      return 1;
+    }
+    return 0;
+  }
+
   for (std::vector<std::pair<int, int> >::iterator itr(viterbi_path.begin());
        itr != viterbi_path.end(); ++itr) {
     if (!sptk::WriteStream(0, length, query_vectors[itr->first], &std::cout,
@@ -44,6 +44,7 @@
 
 #include <getopt.h>
 #include <cctype>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -174,59 +175,76 @@ int main(int argc, char* argv[]) {
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
   uint8_t data;
-  std::ostringstream stored_characters;
+  std::string stored_characters;
+  char address[kBufferSize];
+  const char* hexadecimal_digits("0123456789abcdef");
+  sptk::BufferedStreamReader reader(&input_stream);
+  sptk::BufferedStreamWriter writer(&std::cout);
 
-  for (int index(start_index); sptk::ReadStream(&data, &input_stream);
-       ++index) {
+  for (int index(start_index); reader.Read(&data); ++index) {
     // output address
     if (0 == (index - start_index) % num_column) {
+      const char* address_format_string(NULL);
       switch (address_format) {
         case kNone: {
           // nothing to do
           break;
         }
         case kHexadecimal: {
-          std::cout << std::setfill('0') << std::setw(6) << std::hex << index
-                    << "  ";
+          address_format_string = "%06x  ";
           break;
         }
         case kDecimal: {
-          std::cout << std::setfill('0') << std::setw(6) << std::dec << index
-                    << "  ";
+          address_format_string = "%06d  ";
           break;
         }
         case kOctal: {
-          std::cout << std::setfill('0') << std::setw(6) << std::oct << index
-                    << "  ";
+          address_format_string = "%06o  ";
           break;
         }
         default: { break; }
       }
+      if (NULL != address_format_string) {
+        std::snprintf(address, sizeof(address), address_format_string, index);
+        writer.WriteString(address);
+      }
     }
 
     // stack human-readable characters
     if (std::isprint(data)) {
-      stored_characters << data;
+      stored_characters += static_cast<char>(data);
     } else {
-      stored_characters << ".";
+      stored_characters += '.';
     }
 
     // output data
-    std::cout << std::setfill('0') << std::setw(2) << std::hex
-              << static_cast<int>(data) << " ";
+    const char hexadecimal_data[] = {hexadecimal_digits[data >> 4],
+                                     hexadecimal_digits[data & 0xf], ' '};
+    writer.Write(sizeof(hexadecimal_data), hexadecimal_data);
 
     // output new line
     if (num_column - 1 == (index - start_index) % num_column) {
-      std::cout << "|" << stored_characters.str() << "|" << std::endl;
-      stored_characters.str("");  // clear
+      writer.Write('|');
+      writer.WriteString(stored_characters.c_str());
+      writer.WriteString("|\n");
+      stored_characters.clear();
     }
   }
 
   // flush
-  const std::string residual_characters(stored_characters.str());
-  if (!residual_characters.empty()) {
-    const std::string space(3 * (num_column - residual_characters.size()), ' ');
-    std::cout << space << "|" << residual_characters << "|" << std::endl;
+  if (!stored_characters.empty()) {
+    const std::string space(3 * (num_column - stored_characters.size()), ' ');
+    writer.WriteString(space.c_str());
+    writer.Write('|');
+    writer.WriteString(stored_characters.c_str());
+    writer.WriteString("|\n");
+  }
+
+  if (!writer.Flush()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write data";
+    sptk::PrintErrorMessage("fd", error_message);
+    return 1;
   }
 
   return 0;
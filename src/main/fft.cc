@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -51,6 +52,7 @@
 #include <vector>
 
 #include "SPTK/math/fast_fourier_transform.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -67,6 +69,9 @@ enum OutputFormats {
 const int kDefaultFftLength(256);
 const OutputFormats kDefaultOutputFormat(kOutputRealAndImaginaryParts);
 
+// number of frames transformed at once
+const int kNumFramesInBatch(64);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -88,8 +93,6 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       data sequence                          (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
   *stream << "       FFT sequence                           (double)" << std::endl;  // NOLINT
-  *stream << "  notice:" << std::endl;
-  *stream << "       value of l must be a power of 2" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -191,7 +194,7 @@ int main(int argc, char* argv[]) {
   sptk::FastFourierTransform fast_fourier_transform(num_order, fft_length);
   if (!fast_fourier_transform.IsValid()) {
     std::ostringstream error_message;
-    error_message << "FFT length must be a power of 2";
+    error_message << "FFT length must be a positive integer";
     sptk::PrintErrorMessage("fft", error_message);
     return 1;
   }
@@ -201,44 +204,83 @@ int main(int argc, char* argv[]) {
   std::vector<double> input_y(length);
   std::vector<double> output_x(fft_length);
   std::vector<double> output_y(fft_length);
+  sptk::Matrix input_frames_x(kNumFramesInBatch, length);
+  sptk::Matrix input_frames_y(kNumFramesInBatch, length);
+  sptk::Matrix last_input_frames_x;
+  sptk::Matrix last_input_frames_y;
+  sptk::Matrix output_frames_x;
+  sptk::Matrix output_frames_y;
+
+  for (bool is_end_of_stream(false); !is_end_of_stream;) {
+    // read frames as many as the batch size
+    int num_frames(0);
+    for (; num_frames < kNumFramesInBatch; ++num_frames) {
+      if (!sptk::ReadStream(true, 0, 0, length, &input_x, &input_stream,
+                            NULL) ||
+          !sptk::ReadStream(true, 0, 0, length, &input_y, &input_stream,
+                            NULL)) {
+        is_end_of_stream = true;
+        break;
+      }
+      std::copy(input_x.begin(), input_x.end(), input_frames_x[num_frames]);
+      std::copy(input_y.begin(), input_y.end(), input_frames_y[num_frames]);
+    }
+    if (0 == num_frames) break;
 
-  while (sptk::ReadStream(true, 0, 0, length, &input_x, &input_stream, NULL) &&
-         sptk::ReadStream(true, 0, 0, length, &input_y, &input_stream, NULL)) {
-    if (!fast_fourier_transform.Run(input_x, input_y, &output_x, &output_y)) {
+    if (num_frames < kNumFramesInBatch) {
+      input_frames_x.GetSubmatrix(0, num_frames, 0, length,
+                                  &last_input_frames_x);
+      input_frames_y.GetSubmatrix(0, num_frames, 0, length,
+                                  &last_input_frames_y);
+    }
+    if (!fast_fourier_transform.Run(
+            num_frames < kNumFramesInBatch ? last_input_frames_x
+                                           : input_frames_x,
+            num_frames < kNumFramesInBatch ? last_input_frames_y
+                                           : input_frames_y,
+            &output_frames_x, &output_frames_y)) {
       std::ostringstream error_message;
       error_message << "Failed to run fast Fourier transform";
       sptk::PrintErrorMessage("fft", error_message);
       return 1;
     }
 
-    if (kOutputAmplitude == output_format) {
-      for (int i(0); i < fft_length; ++i) {
-        output_x[i] =
-            std::sqrt(output_x[i] * output_x[i] + output_y[i] * output_y[i]);
-      }
-    } else if (kOutputPower == output_format) {
-      for (int i(0); i < fft_length; ++i) {
-        output_x[i] = output_x[i] * output_x[i] + output_y[i] * output_y[i];
+    for (int n(0); n < num_frames; ++n) {
+      std::copy(output_frames_x[n], output_frames_x[n] + fft_length,
+                output_x.begin());
+      std::copy(output_frames_y[n], output_frames_y[n] + fft_length,
+                output_y.begin());
+
+      if (kOutputAmplitude == output_format) {
+        for (int i(0); i < fft_length; ++i) {
+          output_x[i] =
+              std::sqrt(output_x[i] * output_x[i] + output_y[i] * output_y[i]);
+        }
+      } else if (kOutputPower == output_format) {
+        for (int i(0); i < fft_length; ++i) {
+          output_x[i] = output_x[i] * output_x[i] + output_y[i] * output_y[i];
+        }
       }
-    }
 
-    if ((kOutputRealAndImaginaryParts == output_format ||
-         kOutputRealPart == output_format ||
-         kOutputAmplitude == output_format || kOutputPower == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write output sequence";
-      sptk::PrintErrorMessage("fft", error_message);
-      return 1;
-    }
+      if ((kOutputRealAndImaginaryParts == output_format ||
+           kOutputRealPart == output_format ||
+           kOutputAmplitude == output_format ||
+           kOutputPower == output_format) &&
+          !sptk::WriteStream(0, fft_length, output_x, &std::cout, NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write output sequence";
+        sptk::PrintErrorMessage("fft", error_message);
+        return 1;
+      }
 
-    if ((kOutputRealAndImaginaryParts == output_format ||
-         kOutputImaginaryPart == output_format) &&
-        !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write imaginary parts";
-      sptk::PrintErrorMessage("fft", error_message);
-      return 1;
+      if ((kOutputRealAndImaginaryParts == output_format ||
+           kOutputImaginaryPart == output_format) &&
+          !sptk::WriteStream(0, fft_length, output_y, &std::cout, NULL)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write imaginary parts";
+        sptk::PrintErrorMessage("fft", error_message);
+        return 1;
+      }
     }
   }
 
@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -51,6 +52,7 @@
 #include <vector>
 
 #include "SPTK/math/fast_fourier_transform_for_real_sequence.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -68,6 +70,9 @@ const int kDefaultFftLength(256);
 const OutputFormats kDefaultOutputFormat(kOutputRealAndImaginaryParts);
 const bool kDefaultHalfLengthOutputFlag(false);
 
+// number of frames transformed at once
+const int kDefaultNumThread(1);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -85,13 +90,14 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 3 (amplitude)" << std::endl;
   *stream << "                 4 (power)" << std::endl;
   *stream << "       -H    : output half length             (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultHalfLengthOutputFlag) << "]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads              (   int)[" << std::setw(5) << std::right << kDefaultNumThread    << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence                          (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
   *stream << "       FFT sequence                           (double)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
-  *stream << "       value of l must be a power of 2" << std::endl;
+  *stream << "       value of l must be even" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -106,9 +112,10 @@ int main(int argc, char* argv[]) {
   bool is_num_order_specified(false);
   OutputFormats output_format(kDefaultOutputFormat);
   bool half_length_output_flag(kDefaultHalfLengthOutputFlag);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:o:Hh", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "l:m:o:Hj:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -152,6 +159,17 @@ int main(int argc, char* argv[]) {
         half_length_output_flag = true;
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("fftr", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -196,59 +214,87 @@ int main(int argc, char* argv[]) {
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
   // prepare for fast Fourier transform
-  sptk::FastFourierTransformForRealSequence fast_fourier_transform(num_order,
-                                                                   fft_length);
-  sptk::FastFourierTransformForRealSequence::Buffer buffer;
+  sptk::FastFourierTransformForRealSequence fast_fourier_transform(
+      num_order, fft_length, half_length_output_flag);
+  std::vector<sptk::FastFourierTransformForRealSequence::Buffer> buffers(
+      num_thread);
   if (!fast_fourier_transform.IsValid()) {
     std::ostringstream error_message;
-    error_message << "FFT length must be a power of 2 and greater than 1";
+    error_message << "FFT length must be even and greater than 1";
     sptk::PrintErrorMessage("fftr", error_message);
     return 1;
   }
 
+  // an output frame holds the real parts followed by the imaginary parts
   const int input_length(num_order + 1);
-  const int output_length(half_length_output_flag ? (fft_length / 2 + 1)
-                                                  : fft_length);
-  std::vector<double> input_x(input_length);
-  std::vector<double> output_x(fft_length);
-  std::vector<double> output_y(fft_length);
-
-  while (sptk::ReadStream(true, 0, 0, input_length, &input_x, &input_stream,
-                          NULL)) {
-    if (!fast_fourier_transform.Run(input_x, &output_x, &output_y, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run fast Fourier transform";
-      sptk::PrintErrorMessage("fftr", error_message);
-      return 1;
-    }
+  const int output_length(fast_fourier_transform.GetOutputLength());
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, 2 * output_length, num_thread, true);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("fftr", error_message);
+    return 1;
+  }
 
-    if (kOutputAmplitude == output_format) {
-      for (int i(0); i < output_length; ++i) {
-        output_x[i] =
-            std::sqrt(output_x[i] * output_x[i] + output_y[i] * output_y[i]);
-      }
-    } else if (kOutputPower == output_format) {
-      for (int i(0); i < output_length; ++i) {
-        output_x[i] = output_x[i] * output_x[i] + output_y[i] * output_y[i];
-      }
-    }
+  // each thread has its own working memory
+  std::vector<sptk::Matrix> output_x(num_thread);
+  std::vector<sptk::Matrix> output_y(num_thread);
+
+  // transform a block of frames at once
+  const sptk::ParallelFrameProcessing::BlockProcessor block_processor(
+      [&](const sptk::Matrix& input_x, sptk::Matrix* output,
+          int thread_index) {
+        sptk::Matrix& x(output_x[thread_index]);
+        sptk::Matrix& y(output_y[thread_index]);
+        if (!fast_fourier_transform.Run(input_x, &x, &y,
+                                        &buffers[thread_index])) {
+          return false;
+        }
+
+        const int num_frame(input_x.GetNumRow());
+        if (output->GetNumRow() != num_frame ||
+            output->GetNumColumn() != 2 * output_length) {
+          output->Resize(num_frame, 2 * output_length);
+        }
+        for (int n(0); n < num_frame; ++n) {
+          double* x_n(x[n]);
+          const double* y_n(y[n]);
+          if (kOutputAmplitude == output_format) {
+            for (int i(0); i < output_length; ++i) {
+              x_n[i] = std::sqrt(x_n[i] * x_n[i] + y_n[i] * y_n[i]);
+            }
+          } else if (kOutputPower == output_format) {
+            for (int i(0); i < output_length; ++i) {
+              x_n[i] = x_n[i] * x_n[i] + y_n[i] * y_n[i];
+            }
+          }
+          std::copy(x_n, x_n + output_length, (*output)[n]);
+          std::copy(y_n, y_n + output_length, (*output)[n] + output_length);
+        }
+        return true;
+      });
 
+  auto frame_writer = [&](const std::vector<double>& output) {
     if (kOutputImaginaryPart != output_format &&
-        !sptk::WriteStream(0, output_length, output_x, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write output sequence";
-      sptk::PrintErrorMessage("fftr", error_message);
-      return 1;
+        !sptk::WriteStream(0, output_length, output, &std::cout, NULL)) {
+      return false;
     }
-
     if ((kOutputRealAndImaginaryParts == output_format ||
          kOutputImaginaryPart == output_format) &&
-        !sptk::WriteStream(0, output_length, output_y, &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write imaginary parts";
-      sptk::PrintErrorMessage("fftr", error_message);
-      return 1;
+        !sptk::WriteStream(output_length, output_length, output, &std::cout,
+                           NULL)) {
+      return false;
     }
+    return true;
+  };
+
+  if (!parallel_frame_processing.Run(block_processor, frame_writer,
+                                     &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to run fast Fourier transform";
+    sptk::PrintErrorMessage("fftr", error_message);
+    return 1;
   }
 
   return 0;
@@ -50,6 +50,7 @@
 #include <vector>
 
 #include "SPTK/math/frequency_transform.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -58,6 +59,7 @@ const int kDefaultNumInputOrder(25);
 const int kDefaultNumOutputOrder(25);
 const double kDefaultInputAlpha(0.0);
 const double kDefaultOutputAlpha(0.35);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -71,6 +73,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -M M  : order of warped sequence             (   int)[" << std::setw(5) << std::right << kDefaultNumOutputOrder << "][ 0 <= M <=   ]" << std::endl;  // NOLINT
   *stream << "       -a a  : all-pass constant of input sequence  (double)[" << std::setw(5) << std::right << kDefaultInputAlpha     << "][   <= a <=   ]" << std::endl;  // NOLINT
   *stream << "       -A A  : all-pass constant of output sequence (double)[" << std::setw(5) << std::right << kDefaultOutputAlpha    << "][   <= A <=   ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads                    (   int)[" << std::setw(5) << std::right << kDefaultNumThread      << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       minimum phase sequence                       (double)[stdin]" << std::endl;  // NOLINT
@@ -89,9 +92,10 @@ int main(int argc, char* argv[]) {
   int num_output_order(kDefaultNumOutputOrder);
   double input_alpha(kDefaultInputAlpha);
   double output_alpha(kDefaultOutputAlpha);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "m:M:a:A:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "m:M:a:A:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -135,6 +139,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("freqt", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -179,8 +194,8 @@ int main(int argc, char* argv[]) {
 
   // prepare for frequency transform
   sptk::FrequencyTransform frequency_transform(num_input_order,
-                                               num_output_order, alpha);
-  sptk::FrequencyTransform::Buffer buffer;
+                                               num_output_order, alpha, true);
+  std::vector<sptk::FrequencyTransform::Buffer> buffers(num_thread);
   if (!frequency_transform.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition of frequency transform";
@@ -190,26 +205,32 @@ int main(int argc, char* argv[]) {
 
   const int input_length(num_input_order + 1);
   const int output_length(num_output_order + 1);
-  std::vector<double> minimum_phase_sequence(input_length);
-  std::vector<double> warped_sequence(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &minimum_phase_sequence,
-                          &input_stream, NULL)) {
-    if (!frequency_transform.Run(minimum_phase_sequence, &warped_sequence,
-                                 &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run frequency transform";
-      sptk::PrintErrorMessage("freqt", error_message);
-      return 1;
-    }
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, output_length, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set the condition of parallel processing";
+    sptk::PrintErrorMessage("freqt", error_message);
+    return 1;
+  }
 
-    if (!sptk::WriteStream(0, output_length, warped_sequence, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write warped sequence";
-      sptk::PrintErrorMessage("freqt", error_message);
-      return 1;
-    }
+  if (!parallel_frame_processing.Run(
+          [&frequency_transform, &buffers](
+              const std::vector<double>& minimum_phase_sequence,
+              std::vector<double>* warped_sequence, int thread_index) {
+            return frequency_transform.Run(minimum_phase_sequence,
+                                           warped_sequence,
+                                           &buffers[thread_index]);
+          },
+          [output_length](const std::vector<double>& warped_sequence) {
+            return sptk::WriteStream(0, output_length, warped_sequence,
+                                     &std::cout, NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to run frequency transform";
+    sptk::PrintErrorMessage("freqt", error_message);
+    return 1;
   }
 
   return 0;
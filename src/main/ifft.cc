@@ -92,8 +92,6 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       data sequence                          (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
   *stream << "       inverse FFT sequence                   (double)" << std::endl;  // NOLINT
-  *stream << "  notice:" << std::endl;
-  *stream << "       value of l must be a power of 2" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -188,7 +186,7 @@ int main(int argc, char* argv[]) {
       fft_length - 1, fft_length);
   if (!inverse_fast_fourier_transform.IsValid()) {
     std::ostringstream error_message;
-    error_message << "FFT length must be a power of 2";
+    error_message << "FFT length must be a positive integer";
     sptk::PrintErrorMessage("ifft", error_message);
     return 1;
   }
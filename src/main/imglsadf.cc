@@ -380,7 +380,9 @@ int main(int argc, char* argv[]) {
                                                        &input_source);
   sptk::InputSourceInterpolation interpolation(
       frame_period, interpolation_period, true, &preprocessing);
-  double filter_input, filter_output;
+  std::vector<double> increments_of_filter_coefficients(filter_length);
+  std::vector<double> filter_input(frame_period);
+  std::vector<double> filter_output(frame_period);
 
   sptk::InverseMglsaDigitalFilter filter(num_filter_order, num_pade_order,
                                          num_stage, alpha, transposition_flag);
@@ -393,23 +395,41 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  while (sptk::ReadStream(&filter_input, &stream_for_filter_input)) {
-    if (!interpolation.Get(&filter_coefficients)) {
-      std::ostringstream error_message;
-      error_message << "Cannot get filter coefficients";
-      sptk::PrintErrorMessage("imglsadf", error_message);
-      return 1;
-    }
+  sptk::BufferedStreamReader reader(&stream_for_filter_input);
+  sptk::BufferedStreamWriter writer(&std::cout);
+  for (bool is_final_block(false); !is_final_block;) {
+    int num_samples(0);
+    is_final_block =
+        !reader.Read(frame_period, &(filter_input[0]), &num_samples);
+    if (num_samples <= 0) break;
+
+    // Filter each run of samples over which the coefficients are fixed or
+    // updated at every sample.
+    for (int t(0), run_length(0); t < num_samples; t += run_length) {
+      if (!interpolation.Get(num_samples - t, &filter_coefficients,
+                             &increments_of_filter_coefficients,
+                             &run_length)) {
+        std::ostringstream error_message;
+        error_message << "Cannot get filter coefficients";
+        sptk::PrintErrorMessage("imglsadf", error_message);
+        return 1;
+      }
 
-    if (!filter.Run(filter_coefficients, filter_input, &filter_output,
-                    &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to apply inverse MGLSA digital filter";
-      sptk::PrintErrorMessage("imglsadf", error_message);
-      return 1;
+      if (1 == interpolation_period
+              ? !filter.RunBlock(filter_coefficients,
+                                 increments_of_filter_coefficients,
+                                 &(filter_input[t]), &(filter_output[t]),
+                                 run_length, &buffer)
+              : !filter.RunBlock(filter_coefficients, &(filter_input[t]),
+                                 &(filter_output[t]), run_length, &buffer)) {
+        std::ostringstream error_message;
+        error_message << "Failed to apply inverse MGLSA digital filter";
+        sptk::PrintErrorMessage("imglsadf", error_message);
+        return 1;
+      }
     }
 
-    if (!sptk::WriteStream(filter_output, &std::cout)) {
+    if (!writer.Write(num_samples, &(filter_output[0]))) {
       std::ostringstream error_message;
       error_message << "Failed to write a filter output";
       sptk::PrintErrorMessage("imglsadf", error_message);
@@ -417,5 +437,12 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (!writer.Flush()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write a filter output";
+    sptk::PrintErrorMessage("imglsadf", error_message);
+    return 1;
+  }
+
   return 0;
 }
@@ -49,6 +49,8 @@
 #include <sstream>
 #include <vector>
 
+#include "SPTK/input/input_source_from_mapped_file.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/math/statistics_accumulator.h"
 #include "SPTK/quantizer/linde_buzo_gray_algorithm.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -62,6 +64,7 @@ const int kDefaultMinimumNumVectorInCluster(1);
 const int kDefaultNumIteration(1000);
 const double kDefaultConvergenceThreshold(1e-5);
 const double kDefaultSplittingFactor(1e-5);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -79,6 +82,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "               initial codebook" << std::endl;
   *stream << "       -I I  : output filename of int type   (string)[" << std::setw(5) << std::right << "N/A"                             << "]" << std::endl;  // NOLINT
   *stream << "               codebook index" << std::endl;
+  *stream << "       -j j  : number of threads             (   int)[" << std::setw(5) << std::right << kDefaultNumThread                 << "][   0 <  j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "     (level 2)" << std::endl;
   *stream << "       -n n  : minimum number of vectors in  (   int)[" << std::setw(5) << std::right << kDefaultMinimumNumVectorInCluster << "][   0 <  n <=   ]" << std::endl;  // NOLINT
@@ -111,10 +115,11 @@ int main(int argc, char* argv[]) {
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
   double splitting_factor(kDefaultSplittingFactor);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "l:m:s:e:C:I:n:i:d:r:h", NULL, NULL));
+        getopt_long(argc, argv, "l:m:s:e:C:I:j:n:i:d:r:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -169,6 +174,17 @@ int main(int argc, char* argv[]) {
         codebook_index_file = optarg;
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lbg", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'n': {
         if (!sptk::ConvertStringToInteger(optarg,
                                           &minimum_num_vector_in_cluster) ||
@@ -235,22 +251,33 @@ int main(int argc, char* argv[]) {
   }
   const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
+  const int length(num_order + 1);
+
   // open stream
+  sptk::InputSourceFromMappedFile input_source_from_file(false, 0, length,
+                                                         input_file);
   std::ifstream ifs;
-  ifs.open(input_file, std::ios::in | std::ios::binary);
-  if (ifs.fail() && NULL != input_file) {
-    std::ostringstream error_message;
-    error_message << "Cannot open file " << input_file;
-    sptk::PrintErrorMessage("lbg", error_message);
-    return 1;
+  if (!input_source_from_file.IsValid()) {
+    ifs.open(input_file, std::ios::in | std::ios::binary);
+    if (ifs.fail() && NULL != input_file) {
+      std::ostringstream error_message;
+      error_message << "Cannot open file " << input_file;
+      sptk::PrintErrorMessage("lbg", error_message);
+      return 1;
+    }
   }
-  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+  std::istream& input_stream(ifs.is_open() ? ifs : std::cin);
+  sptk::InputSourceFromStream input_source_from_stream(false, length,
+                                                       &input_stream);
+  sptk::InputSourceInterface& input_source(
+      input_source_from_file.IsValid()
+          ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+          : input_source_from_stream);
 
-  const int length(num_order + 1);
   std::vector<std::vector<double> > input_vectors;
   {
     std::vector<double> tmp(length);
-    while (sptk::ReadStream(false, 0, 0, length, &tmp, &input_stream, NULL)) {
+    while (input_source.Get(&tmp)) {
       input_vectors.push_back(tmp);
     }
   }
@@ -309,7 +336,7 @@ int main(int argc, char* argv[]) {
   sptk::LindeBuzoGrayAlgorithm codebook_designer(
       num_order, seed, codebook_vectors.size(), target_codebook_size,
       minimum_num_vector_in_cluster, num_iteration, convergence_threshold,
-      splitting_factor);
+      splitting_factor, num_thread);
   if (!codebook_designer.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition for codebook design";
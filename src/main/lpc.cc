@@ -43,6 +43,7 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -51,6 +52,7 @@
 
 #include "SPTK/converter/waveform_to_autocorrelation.h"
 #include "SPTK/math/levinson_durbin_recursion.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -61,6 +63,7 @@ const int kDefaultFrameLength(256);
 const int kDefaultNumOrder(25);
 const double kDefaultEpsilon(0.0);
 const WarningType kDefaultWarningType(kIgnore);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -79,6 +82,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (output the index to stderr)" << std::endl;
   *stream << "                 2 (output the index to stderr and" << std::endl;
   *stream << "                    exit immediately)" << std::endl;
+  *stream << "       -j j  : number of threads                       (   int)[" << std::setw(5) << std::right << kDefaultNumThread   << "][   1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       windowed sequence                               (double)[stdin]" << std::endl;  // NOLINT
@@ -97,9 +101,10 @@ int main(int argc, char* argv[]) {
   int num_order(kDefaultNumOrder);
   double epsilon(kDefaultEpsilon);
   WarningType warning_type(kDefaultWarningType);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:f:e:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "l:m:f:e:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -150,6 +155,17 @@ int main(int argc, char* argv[]) {
         warning_type = static_cast<WarningType>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lpc", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -192,7 +208,7 @@ int main(int argc, char* argv[]) {
   }
 
   sptk::LevinsonDurbinRecursion levinson_durbin_recursion(num_order, epsilon);
-  sptk::LevinsonDurbinRecursion::Buffer buffer;
+  std::vector<sptk::LevinsonDurbinRecursion::Buffer> buffers(num_thread);
   if (!levinson_durbin_recursion.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for Levinson-Durbin recursion";
@@ -200,46 +216,69 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  // the last element of an output frame holds the stability flag
   const int output_length(num_order + 1);
-  std::vector<double> windowed_sequence(frame_length);
-  std::vector<double> autocorrelation_sequence(output_length);
-  std::vector<double> linear_predictive_coefficients(output_length);
-
-  for (int frame_index(0); sptk::ReadStream(
-           false, 0, 0, frame_length, &windowed_sequence, &input_stream, NULL);
-       ++frame_index) {
-    if (!waveform_to_autocorrelation.Run(windowed_sequence,
-                                         &autocorrelation_sequence)) {
-      std::ostringstream error_message;
-      error_message << "Failed to obtain autocorrelation sequence";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      frame_length, output_length + 1, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("lpc", error_message);
+    return 1;
+  }
+
+  // each thread has its own working memory
+  std::vector<std::vector<double> > autocorrelation_sequences(
+      num_thread, std::vector<double>(output_length));
+  std::vector<std::vector<double> > linear_predictive_coefficients(
+      num_thread, std::vector<double>(output_length));
+
+  auto frame_processor = [&](const std::vector<double>& windowed_sequence,
+                             std::vector<double>* output, int thread_index) {
+    if (!waveform_to_autocorrelation.Run(
+            windowed_sequence, &autocorrelation_sequences[thread_index])) {
+      return false;
     }
 
     bool is_stable(false);
-    if (!levinson_durbin_recursion.Run(autocorrelation_sequence,
-                                       &linear_predictive_coefficients,
-                                       &is_stable, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to solve autocorrelation normal equations";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
+    if (!levinson_durbin_recursion.Run(
+            autocorrelation_sequences[thread_index],
+            &linear_predictive_coefficients[thread_index], &is_stable,
+            &buffers[thread_index])) {
+      return false;
     }
 
+    std::copy(linear_predictive_coefficients[thread_index].begin(),
+              linear_predictive_coefficients[thread_index].end(),
+              output->begin());
+    (*output)[output_length] = is_stable ? 1.0 : 0.0;
+    return true;
+  };
+
+  int frame_index(0);
+  bool is_unstable_frame_found(false);
+  auto frame_writer = [&](const std::vector<double>& output) {
+    const bool is_stable(0.0 != output[output_length]);
     if (!is_stable && kIgnore != warning_type) {
       std::ostringstream error_message;
       error_message << frame_index << "th frame is unstable";
       sptk::PrintErrorMessage("lpc", error_message);
-      if (kExit == warning_type) return 1;
+      if (kExit == warning_type) {
+        is_unstable_frame_found = true;
+        return false;
+      }
     }
+    ++frame_index;
+    return sptk::WriteStream(0, output_length, output, &std::cout, NULL);
+  };
 
-    if (!sptk::WriteStream(0, output_length, linear_predictive_coefficients,
-                           &std::cout, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write linear predictive coefficients";
-      sptk::PrintErrorMessage("lpc", error_message);
-      return 1;
-    }
+  if (!parallel_frame_processing.Run(frame_processor, frame_writer,
+                                     &input_stream)) {
+    if (is_unstable_frame_found) return 1;
+    std::ostringstream error_message;
+    error_message << "Failed to obtain linear predictive coefficients";
+    sptk::PrintErrorMessage("lpc", error_message);
+    return 1;
   }
 
   return 0;
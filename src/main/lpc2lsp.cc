@@ -53,6 +53,7 @@
 #include <vector>
 
 #include "SPTK/converter/linear_predictive_coefficients_to_line_spectral_pairs.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -79,6 +80,7 @@ const OutputFormats kDefaultOutputFormat(kNormalizedFrequencyInRadians);
 const int kDefaultNumSplit(256);
 const int kDefaultNumIteration(4);
 const double kDefaultConvergenceThreshold(1e-6);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -99,6 +101,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 1 (normalized frequency [0...1/2])" << std::endl;
   *stream << "                 2 (frequency [kHz])" << std::endl;
   *stream << "                 3 (frequency [Hz])" << std::endl;
+  *stream << "       -j j  : number of threads                       (   int)[" << std::setw(5) << std::right << kDefaultNumThread            << "][   1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "     (level 2)" << std::endl;
   *stream << "       -n n  : number of splits of unit circle         (   int)[" << std::setw(5) << std::right << kDefaultNumSplit             << "][   0 <  n <=   ]" << std::endl;  // NOLINT
@@ -124,10 +127,11 @@ int main(int argc, char* argv[]) {
   int num_split(kDefaultNumSplit);
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:s:k:o:n:i:d:h", NULL, NULL));
+        getopt_long(argc, argv, "m:s:k:o:n:i:d:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -216,6 +220,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("lpc2lsp", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -252,7 +267,8 @@ int main(int argc, char* argv[]) {
   sptk::LinearPredictiveCoefficientsToLineSpectralPairs
       linear_predictive_coefficients_to_line_spectral_pairs(
           num_order, num_split, num_iteration, convergence_threshold);
-  sptk::LinearPredictiveCoefficientsToLineSpectralPairs::Buffer buffer;
+  std::vector<sptk::LinearPredictiveCoefficientsToLineSpectralPairs::Buffer>
+      buffers(num_thread);
   if (!linear_predictive_coefficients_to_line_spectral_pairs.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for transformation";
@@ -263,25 +279,29 @@ int main(int argc, char* argv[]) {
   const int length(num_order + 1);
   const int write_size(kWithoutGain == output_gain_type ? num_order : length);
   const int begin(kWithoutGain == output_gain_type ? 1 : 0);
-  std::vector<double> linear_predictive_coefficients(length);
-  std::vector<double> line_spectral_pairs(length);
+  sptk::ParallelFrameProcessing parallel_frame_processing(length, length,
+                                                          num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("lpc2lsp", error_message);
+    return 1;
+  }
 
-  while (sptk::ReadStream(false, 0, 0, length, &linear_predictive_coefficients,
-                          &input_stream, NULL)) {
+  auto frame_processor = [&](
+      const std::vector<double>& linear_predictive_coefficients,
+      std::vector<double>* line_spectral_pairs, int thread_index) {
     if (!linear_predictive_coefficients_to_line_spectral_pairs.Run(
-            linear_predictive_coefficients, &line_spectral_pairs, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to transform linear predictive coefficients to "
-                       "line spectral pairs";
-      sptk::PrintErrorMessage("lpc2lsp", error_message);
-      return 1;
+            linear_predictive_coefficients, line_spectral_pairs,
+            &buffers[thread_index])) {
+      return false;
     }
 
     switch (output_format) {
       case kNormalizedFrequencyInRadians: {
-        std::transform(line_spectral_pairs.begin() + 1,
-                       line_spectral_pairs.end(),
-                       line_spectral_pairs.begin() + 1,
+        std::transform(line_spectral_pairs->begin() + 1,
+                       line_spectral_pairs->end(),
+                       line_spectral_pairs->begin() + 1,
                        std::bind1st(std::multiplies<double>(), sptk::kTwoPi));
         break;
       }
@@ -291,15 +311,15 @@ int main(int argc, char* argv[]) {
       }
       case kFrequecnyInkHz: {
         std::transform(
-            line_spectral_pairs.begin() + 1, line_spectral_pairs.end(),
-            line_spectral_pairs.begin() + 1,
+            line_spectral_pairs->begin() + 1, line_spectral_pairs->end(),
+            line_spectral_pairs->begin() + 1,
             std::bind1st(std::multiplies<double>(), sampling_frequency));
         break;
       }
       case kFrequecnyInHz: {
-        std::transform(line_spectral_pairs.begin() + 1,
-                       line_spectral_pairs.end(),
-                       line_spectral_pairs.begin() + 1,
+        std::transform(line_spectral_pairs->begin() + 1,
+                       line_spectral_pairs->end(),
+                       line_spectral_pairs->begin() + 1,
                        std::bind1st(std::multiplies<double>(),
                                     1000.0 * sampling_frequency));
         break;
@@ -313,7 +333,7 @@ int main(int argc, char* argv[]) {
         break;
       }
       case kLogGain: {
-        line_spectral_pairs[0] = std::log(line_spectral_pairs[0]);
+        (*line_spectral_pairs)[0] = std::log((*line_spectral_pairs)[0]);
         break;
       }
       case kWithoutGain: {
@@ -323,13 +343,21 @@ int main(int argc, char* argv[]) {
       default: { break; }
     }
 
-    if (!sptk::WriteStream(begin, write_size, line_spectral_pairs, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write line spectral pairs";
-      sptk::PrintErrorMessage("lpc2lsp", error_message);
-      return 1;
-    }
+    return true;
+  };
+
+  if (!parallel_frame_processing.Run(
+          frame_processor,
+          [begin, write_size](const std::vector<double>& line_spectral_pairs) {
+            return sptk::WriteStream(begin, write_size, line_spectral_pairs,
+                                     &std::cout, NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to transform linear predictive coefficients to "
+                     "line spectral pairs";
+    sptk::PrintErrorMessage("lpc2lsp", error_message);
+    return 1;
   }
 
   return 0;
@@ -222,7 +222,9 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  while (sptk::ReadStream(&filter_input, &stream_for_filter_input)) {
+  sptk::BufferedStreamReader reader(&stream_for_filter_input);
+  sptk::BufferedStreamWriter writer(&std::cout);
+  while (reader.Read(&filter_input)) {
     if (!interpolation.Get(&filter_coefficients)) {
       std::ostringstream error_message;
       error_message << "Cannot get filter coefficients";
@@ -238,7 +240,7 @@ int main(int argc, char* argv[]) {
       return 1;
     }
 
-    if (!sptk::WriteStream(filter_output, &std::cout)) {
+    if (!writer.Write(filter_output)) {
       std::ostringstream error_message;
       error_message << "Failed to write a filter output";
       sptk::PrintErrorMessage("ltcdf", error_message);
@@ -246,5 +248,12 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  if (!writer.Flush()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write a filter output";
+    sptk::PrintErrorMessage("ltcdf", error_message);
+    return 1;
+  }
+
   return 0;
 }
@@ -50,6 +50,8 @@
 #include <sstream>
 #include <vector>
 
+#include "SPTK/input/input_source_from_mapped_file.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -170,24 +172,32 @@ int main(int argc, char* argv[]) {
   const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
   // open stream
+  sptk::InputSourceFromMappedFile input_source_from_file(
+      false, 0, vector_length, input_file);
   std::ifstream ifs;
-  ifs.open(input_file, std::ios::in | std::ios::binary);
-  if (ifs.fail() && NULL != input_file) {
-    std::ostringstream error_message;
-    error_message << "Cannot open file " << input_file;
-    sptk::PrintErrorMessage("median", error_message);
-    return 1;
+  if (!input_source_from_file.IsValid()) {
+    ifs.open(input_file, std::ios::in | std::ios::binary);
+    if (ifs.fail() && NULL != input_file) {
+      std::ostringstream error_message;
+      error_message << "Cannot open file " << input_file;
+      sptk::PrintErrorMessage("median", error_message);
+      return 1;
+    }
   }
-  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+  std::istream& input_stream(ifs.is_open() ? ifs : std::cin);
+  sptk::InputSourceFromStream input_source_from_stream(false, vector_length,
+                                                       &input_stream);
+  sptk::InputSourceInterface& input_source(
+      input_source_from_file.IsValid()
+          ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+          : input_source_from_stream);
 
   std::vector<std::vector<double> > input_vectors;
   if (kMagicNumberForEndOfFile != output_interval) {
     input_vectors.reserve(output_interval);
   }
   std::vector<double> data(vector_length);
-  for (int index(1);
-       sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream, NULL);
-       ++index) {
+  for (int index(1); input_source.Get(&data); ++index) {
     input_vectors.push_back(data);
     if (kMagicNumberForEndOfFile != output_interval &&
         0 == index % output_interval) {
@@ -47,9 +47,11 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "SPTK/converter/mel_generalized_cepstrum_to_mel_generalized_cepstrum.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -64,6 +66,8 @@ const double kDefaultOutputAlpha(0.0);
 const double kDefaultOutputGamma(1.0);
 const bool kDefaultOutputNormalizationFlag(false);
 const bool kDefaultOutputMultiplicationFlag(false);
+const int kDefaultNumThread(1);
+const bool kDefaultVerboseFlag(false);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -85,6 +89,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -C C  : gamma of mel-generalized cepstrum = -1 / C (output)  (   int)[" << std::setw(5) << std::right << "N/A"                  << "][ 1 <= C <=   ]" << std::endl;  // NOLINT
   *stream << "       -N    : regard output as normalized mel-generalized cepstrum (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultOutputNormalizationFlag)  << "]" << std::endl;  // NOLINT
   *stream << "       -U    : regard output as multiplied by gamma                 (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultOutputMultiplicationFlag) << "]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads                                    (   int)[" << std::setw(5) << std::right << kDefaultNumThread      << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
+  *stream << "       -v    : print conversion plan to stderr                      (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultVerboseFlag) << "]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       mel-generalized cepstrum                                     (double)[stdin]" << std::endl;  // NOLINT
@@ -112,10 +118,12 @@ int main(int argc, char* argv[]) {
   double output_gamma(kDefaultOutputGamma);
   bool output_normalization_flag(kDefaultOutputNormalizationFlag);
   bool output_multiplication_flag(kDefaultOutputMultiplicationFlag);
+  int num_thread(kDefaultNumThread);
+  bool verbose_flag(kDefaultVerboseFlag);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:a:g:c:nuM:A:G:C:NUh", NULL, NULL));
+        getopt_long(argc, argv, "m:a:g:c:nuM:A:G:C:NUj:vh", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -217,6 +225,21 @@ int main(int argc, char* argv[]) {
         output_multiplication_flag = true;
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("mgc2mgc", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'v': {
+        verbose_flag = true;
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -255,48 +278,74 @@ int main(int argc, char* argv[]) {
           input_num_order, input_alpha, input_gamma, input_normalization_flag,
           input_multiplication_flag, output_num_order, output_alpha,
           output_gamma, output_normalization_flag, output_multiplication_flag);
-  sptk::MelGeneralizedCepstrumToMelGeneralizedCepstrum::Buffer buffer;
+  std::vector<sptk::MelGeneralizedCepstrumToMelGeneralizedCepstrum::Buffer>
+      buffers(num_thread);
   if (!mel_generalized_cepstrum_transform.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set the condition";
     sptk::PrintErrorMessage("mgc2mgc", error_message);
     return 1;
   }
-
-  const int input_length(input_num_order + 1);
-  const int output_length(output_num_order + 1);
-  std::vector<double> mel_generalized_cepstrum(input_length);
-  std::vector<double> transformed_mel_generalized_cepstrum(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &mel_generalized_cepstrum,
-                          &input_stream, NULL)) {
-    // input modification: 1+g*mgc[0] -> mgc[0]
-    if (!input_normalization_flag && input_multiplication_flag)
-      (*mel_generalized_cepstrum.begin()) =
-          (*(mel_generalized_cepstrum.begin()) - 1.0) / input_gamma;
-    // transform
-    if (!mel_generalized_cepstrum_transform.Run(
-            mel_generalized_cepstrum, &transformed_mel_generalized_cepstrum,
-            &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to run mel-generalized cepstral transformation";
-      sptk::PrintErrorMessage("mgc2mgc", error_message);
-      return 1;
+  if (verbose_flag) {
+    const std::vector<std::string>& plan(
+        mel_generalized_cepstrum_transform.GetPlan());
+    std::cerr << "mgc2mgc: conversion plan" << std::endl;
+    if (plan.empty()) {
+      std::cerr << "  copy" << std::endl;
     }
-    // output modification: mgc[0] -> 1+g*mgc[0]
-    if (!output_normalization_flag && output_multiplication_flag)
-      (*transformed_mel_generalized_cepstrum.begin()) =
-          *(transformed_mel_generalized_cepstrum.begin()) * output_gamma + 1.0;
-    // write results
-    if (!sptk::WriteStream(0, output_length,
-                           transformed_mel_generalized_cepstrum, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write mel-generalized cepstrum";
-      sptk::PrintErrorMessage("mgc2mgc", error_message);
-      return 1;
+    for (std::size_t i(0); i < plan.size(); ++i) {
+      std::cerr << "  " << i + 1 << ": " << plan[i] << std::endl;
     }
   }
-
+  const int input_length(input_num_order + 1);
+  const int output_length(output_num_order + 1);
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, output_length, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("mgc2mgc", error_message);
+    return 1;
+  }
+  std::vector<std::vector<double> > mel_generalized_cepstra(
+      num_thread, std::vector<double>(input_length));
+  if (!parallel_frame_processing.Run(
+          [&](const std::vector<double>& input_mel_generalized_cepstrum,
+              std::vector<double>* transformed_mel_generalized_cepstrum,
+              int thread_index) {
+            std::vector<double>& mel_generalized_cepstrum(
+                mel_generalized_cepstra[thread_index]);
+            mel_generalized_cepstrum = input_mel_generalized_cepstrum;
+            // input modification: 1+g*mgc[0] -> mgc[0]
+            if (!input_normalization_flag && input_multiplication_flag)
+              (*mel_generalized_cepstrum.begin()) =
+                  (*(mel_generalized_cepstrum.begin()) - 1.0) / input_gamma;
+            // transform
+            if (!mel_generalized_cepstrum_transform.Run(
+                    mel_generalized_cepstrum,
+                    transformed_mel_generalized_cepstrum,
+                    &buffers[thread_index])) {
+              return false;
+            }
+            // output modification: mgc[0] -> 1+g*mgc[0]
+            if (!output_normalization_flag && output_multiplication_flag)
+              (*transformed_mel_generalized_cepstrum->begin()) =
+                  *(transformed_mel_generalized_cepstrum->begin()) *
+                      output_gamma +
+                  1.0;
+            return true;
+          },
+          [output_length](
+              const std::vector<double>& transformed_mel_generalized_cepstrum) {
+            return sptk::WriteStream(0, output_length,
+                                     transformed_mel_generalized_cepstrum,
+                                     &std::cout, NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to run mel-generalized cepstral transformation";
+    sptk::PrintErrorMessage("mgc2mgc", error_message);
+    return 1;
+  }
   return 0;
 }
@@ -53,6 +53,7 @@
 #include <vector>
 
 #include "SPTK/converter/mel_generalized_cepstrum_to_spectrum.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -75,6 +76,7 @@ const bool kDefaultNormalizationFlag(false);
 const bool kDefaultMultiplicationFlag(false);
 const int kDefaultFftLength(256);
 const OutputFormats kDefaultOutputFormat(kLogAmplitudeSpectrumInDecibels);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -100,13 +102,14 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 4 (arg|H(z)|/pi)" << std::endl;
   *stream << "                 5 (arg|H(z)|)" << std::endl;
   *stream << "                 6 (arg|H(z)|*180/pi)" << std::endl;
+  *stream << "       -j j  : number of threads                          (   int)[" << std::setw(5) << std::right << kDefaultNumThread    << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       mel-generalized cepstrum                           (double)[stdin]" << std::endl;  // NOLINT
   *stream << "  stdout:" << std::endl;
   *stream << "       spectrum                                           (double)" << std::endl;  // NOLINT
   *stream << "  notice:" << std::endl;
-  *stream << "       value of l must be a power of 2" << std::endl;
+  *stream << "       value of l must be even" << std::endl;
   *stream << "       if -u is used without -n, input is regarded as 1+g/mgc[0],g*mgc[1],...,g*mgc[m]" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
@@ -124,10 +127,11 @@ int main(int argc, char* argv[]) {
   bool multiplication_flag(kDefaultMultiplicationFlag);
   int fft_length(kDefaultFftLength);
   OutputFormats output_format(kDefaultOutputFormat);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
     const int option_char(
-        getopt_long(argc, argv, "m:a:g:c:nul:o:h", NULL, NULL));
+        getopt_long(argc, argv, "m:a:g:c:nul:o:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -204,6 +208,17 @@ int main(int argc, char* argv[]) {
         output_format = static_cast<OutputFormats>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("mgc2sp", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -240,7 +255,8 @@ int main(int argc, char* argv[]) {
   sptk::MelGeneralizedCepstrumToSpectrum mel_generalized_cepstrum_to_spectrum(
       num_order, alpha, gamma, normalization_flag, multiplication_flag,
       fft_length);
-  sptk::MelGeneralizedCepstrumToSpectrum::Buffer buffer;
+  std::vector<sptk::MelGeneralizedCepstrumToSpectrum::Buffer> buffers(
+      num_thread);
   if (!mel_generalized_cepstrum_to_spectrum.IsValid()) {
     std::ostringstream error_message;
     error_message << "Failed to set condition for transformation";
@@ -250,12 +266,31 @@ int main(int argc, char* argv[]) {
 
   const int input_length(num_order + 1);
   const int output_length(fft_length / 2 + 1);
-  std::vector<double> mel_generalized_cepstrum(input_length);
-  std::vector<double> amplitude_spectrum(fft_length);
-  std::vector<double> phase_spectrum(fft_length);
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, output_length, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("mgc2sp", error_message);
+    return 1;
+  }
+
+  // each thread has its own working memory
+  std::vector<std::vector<double> > mel_generalized_cepstra(
+      num_thread, std::vector<double>(input_length));
+  std::vector<std::vector<double> > amplitude_spectra(
+      num_thread, std::vector<double>(output_length));
+  std::vector<std::vector<double> > phase_spectra(
+      num_thread, std::vector<double>(output_length));
+
+  auto frame_processor = [&](const std::vector<double>& input,
+                             std::vector<double>* output, int thread_index) {
+    std::vector<double>& mel_generalized_cepstrum(
+        mel_generalized_cepstra[thread_index]);
+    std::vector<double>& amplitude_spectrum(amplitude_spectra[thread_index]);
+    std::vector<double>& phase_spectrum(phase_spectra[thread_index]);
+    mel_generalized_cepstrum = input;
 
-  while (sptk::ReadStream(false, 0, 0, input_length, &mel_generalized_cepstrum,
-                          &input_stream, NULL)) {
     // input modification
     if (!normalization_flag && multiplication_flag) {
       (*mel_generalized_cepstrum.begin()) =
@@ -263,14 +298,10 @@ int main(int argc, char* argv[]) {
     }
 
     // transform
-    if (!mel_generalized_cepstrum_to_spectrum.Run(mel_generalized_cepstrum,
-                                                  &amplitude_spectrum,
-                                                  &phase_spectrum, &buffer)) {
-      std::ostringstream error_message;
-      error_message
-          << "Failed to transform mel-generalized ceptrum to spectrum";
-      sptk::PrintErrorMessage("mgc2sp", error_message);
-      return 1;
+    if (!mel_generalized_cepstrum_to_spectrum.Run(
+            mel_generalized_cepstrum, &amplitude_spectrum, &phase_spectrum,
+            &buffers[thread_index])) {
+      return false;
     }
 
     switch (output_format) {
@@ -326,29 +357,31 @@ int main(int argc, char* argv[]) {
       case kLogAmplitudeSpectrum:
       case kAmplitudeSpectrum:
       case kPowerSpectrum: {
-        if (!sptk::WriteStream(0, output_length, amplitude_spectrum, &std::cout,
-                               NULL)) {
-          std::ostringstream error_message;
-          error_message << "Failed to write amplitude spectrum";
-          sptk::PrintErrorMessage("mgc2sp", error_message);
-          return 1;
-        }
+        *output = amplitude_spectrum;
         break;
       }
       case kPhaseSpectrumInNormalizedRadians:
       case kPhaseSpectrumInRadians:
       case kPhaseSpectrumInDegrees: {
-        if (!sptk::WriteStream(0, output_length, phase_spectrum, &std::cout,
-                               NULL)) {
-          std::ostringstream error_message;
-          error_message << "Failed to write phase spectrum";
-          sptk::PrintErrorMessage("mgc2sp", error_message);
-          return 1;
-        }
+        *output = phase_spectrum;
         break;
       }
-      default: { break; }
+      default: { return false; }
     }
+    return true;
+  };
+
+  if (!parallel_frame_processing.Run(
+          frame_processor,
+          [output_length](const std::vector<double>& spectrum) {
+            return sptk::WriteStream(0, output_length, spectrum, &std::cout,
+                                     NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to transform mel-generalized ceptrum to spectrum";
+    sptk::PrintErrorMessage("mgc2sp", error_message);
+    return 1;
   }
 
   return 0;
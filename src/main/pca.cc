@@ -48,10 +48,11 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
-#include <numeric>
 #include <sstream>
 #include <vector>
 
+#include "SPTK/input/input_source_from_mapped_file.h"
+#include "SPTK/input/input_source_from_stream.h"
 #include "SPTK/math/principal_component_analysis.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -61,6 +62,10 @@ const int kDefaultVectorLength(25);
 const int kDefaultNumPrincipalComponent(2);
 const int kDefaultNumIteration(10000);
 const double kDefaultConvergenceThreshold(1e-6);
+const sptk::PrincipalComponentAnalysis::Algorithms kDefaultAlgorithm(
+    sptk::PrincipalComponentAnalysis::Algorithms::kHouseholderQl);
+const int kDefaultOutputInterval(0);
+const int kNumVectorInBlock(256);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -73,8 +78,15 @@ void PrintUsage(std::ostream* stream) {
   *stream << "       -l l  : length of vector               (   int)[" << std::setw(5) << std::right << kDefaultVectorLength          << "][   1 <= l <=   ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector                (   int)[" << std::setw(5) << std::right << "l-1"                         << "][   0 <= m <=   ]" << std::endl;  // NOLINT
   *stream << "       -n n  : number of principal components (   int)[" << std::setw(5) << std::right << kDefaultNumPrincipalComponent << "][   1 <= n <= l ]" << std::endl;  // NOLINT
+  *stream << "       -a a  : algorithm used for eigenvalue  (   int)[" << std::setw(5) << std::right << kDefaultAlgorithm             << "][   0 <= a <= 1 ]" << std::endl;  // NOLINT
+  *stream << "               decomposition" << std::endl;
+  *stream << "                 0 (Householder and QL)" << std::endl;
+  *stream << "                 1 (subspace iteration)" << std::endl;
   *stream << "       -i i  : maximum number of iterations   (   int)[" << std::setw(5) << std::right << kDefaultNumIteration          << "][   1 <= i <=   ]" << std::endl;  // NOLINT
   *stream << "       -d d  : convergence threshold          (double)[" << std::setw(5) << std::right << kDefaultConvergenceThreshold  << "][ 0.0 <= d <=   ]" << std::endl;  // NOLINT
+  *stream << "               (used only if a = 1)" << std::endl;
+  *stream << "       -u u  : output interval [vector]       (   int)[" << std::setw(5) << std::right << kDefaultOutputInterval        << "][   0 <= u <=   ]" << std::endl;  // NOLINT
+  *stream << "               (if u = 0, output only at the end)" << std::endl;
   *stream << "       -v v  : output filename of double type (string)[" << std::setw(5) << std::right << "N/A"                         << "]" << std::endl;  // NOLINT
   *stream << "               eigenvalues and proportions" << std::endl;
   *stream << "       -h    : print this message" << std::endl;
@@ -88,6 +100,51 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+bool OutputPrincipalComponents(
+    const sptk::PrincipalComponentAnalysis& principal_component_analysis,
+    int vector_length, int num_principal_component,
+    std::ostream* eigenvalue_stream,
+    sptk::PrincipalComponentAnalysis::Buffer* buffer) {
+  std::vector<double> mean_vector(vector_length);
+  std::vector<double> eigenvalues(num_principal_component);
+  sptk::Matrix eigenvector_matrix(num_principal_component, vector_length);
+  if (!principal_component_analysis.Decompose(
+          &mean_vector, &eigenvalues, &eigenvector_matrix, buffer)) {
+    return false;
+  }
+
+  if (!sptk::WriteStream(0, vector_length, mean_vector, &std::cout, NULL)) {
+    return false;
+  }
+
+  if (!sptk::WriteStream(eigenvector_matrix, &std::cout)) {
+    return false;
+  }
+
+  if (NULL != eigenvalue_stream) {
+    if (!sptk::WriteStream(0, num_principal_component, eigenvalues,
+                           eigenvalue_stream, NULL)) {
+      return false;
+    }
+
+    double sum;
+    if (!principal_component_analysis.GetTotalVariance(*buffer, &sum)) {
+      return false;
+    }
+    std::vector<double> proportions(num_principal_component);
+    std::transform(eigenvalues.begin(),
+                   eigenvalues.begin() + num_principal_component,
+                   proportions.begin(),
+                   std::bind1st(std::multiplies<double>(), 1.0 / sum));
+    if (!sptk::WriteStream(0, num_principal_component, proportions,
+                           eigenvalue_stream, NULL)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
@@ -95,10 +152,13 @@ int main(int argc, char* argv[]) {
   int num_principal_component(kDefaultNumPrincipalComponent);
   int num_iteration(kDefaultNumIteration);
   double convergence_threshold(kDefaultConvergenceThreshold);
+  sptk::PrincipalComponentAnalysis::Algorithms algorithm(kDefaultAlgorithm);
+  int output_interval(kDefaultOutputInterval);
   const char* eigenvalues_file(NULL);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:n:i:d:v:h", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:n:a:i:d:u:v:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -136,6 +196,25 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'a': {
+        const int min(0);
+        const int max(
+            static_cast<int>(
+                sptk::PrincipalComponentAnalysis::Algorithms::kNumAlgorithms) -
+            1);
+        int tmp;
+        if (!sptk::ConvertStringToInteger(optarg, &tmp) ||
+            !sptk::IsInRange(tmp, min, max)) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -a option must be an integer "
+                        << "in the range of " << min << " to " << max;
+          sptk::PrintErrorMessage("pca", error_message);
+          return 1;
+        }
+        algorithm =
+            static_cast<sptk::PrincipalComponentAnalysis::Algorithms>(tmp);
+        break;
+      }
       case 'i': {
         if (!sptk::ConvertStringToInteger(optarg, &num_iteration) ||
             num_iteration <= 0) {
@@ -158,6 +237,17 @@ int main(int argc, char* argv[]) {
         }
         break;
       }
+      case 'u': {
+        if (!sptk::ConvertStringToInteger(optarg, &output_interval) ||
+            output_interval < 0) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -u option must be a "
+                        << "non-negative integer";
+          sptk::PrintErrorMessage("pca", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'v': {
         eigenvalues_file = optarg;
         break;
@@ -192,15 +282,25 @@ int main(int argc, char* argv[]) {
   const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
   // open stream
+  sptk::InputSourceFromMappedFile input_source_from_file(
+      false, 0, vector_length, input_file);
   std::ifstream ifs;
-  ifs.open(input_file, std::ios::in | std::ios::binary);
-  if (ifs.fail() && NULL != input_file) {
-    std::ostringstream error_message;
-    error_message << "Cannot open file " << input_file;
-    sptk::PrintErrorMessage("pca", error_message);
-    return 1;
+  if (!input_source_from_file.IsValid()) {
+    ifs.open(input_file, std::ios::in | std::ios::binary);
+    if (ifs.fail() && NULL != input_file) {
+      std::ostringstream error_message;
+      error_message << "Cannot open file " << input_file;
+      sptk::PrintErrorMessage("pca", error_message);
+      return 1;
+    }
   }
-  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+  std::istream& input_stream(ifs.is_open() ? ifs : std::cin);
+  sptk::InputSourceFromStream input_source_from_stream(false, vector_length,
+                                                       &input_stream);
+  sptk::InputSourceInterface& input_source(
+      input_source_from_file.IsValid()
+          ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+          : input_source_from_stream);
 
   // open stream to output eigenvalues
   std::ofstream ofs;
@@ -217,7 +317,8 @@ int main(int argc, char* argv[]) {
 
   // prepare for principal component analysis
   sptk::PrincipalComponentAnalysis principal_component_analysis(
-      vector_length - 1, num_iteration, convergence_threshold);
+      vector_length - 1, num_principal_component, num_iteration,
+      convergence_threshold, algorithm);
   sptk::PrincipalComponentAnalysis::Buffer buffer;
   if (!principal_component_analysis.IsValid()) {
     std::ostringstream error_message;
@@ -226,73 +327,62 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  // read input data
-  std::vector<std::vector<double> > input_vectors;
-  {
-    std::vector<double> tmp(vector_length);
-    while (sptk::ReadStream(false, 0, 0, vector_length, &tmp, &input_stream,
-                            NULL)) {
-      input_vectors.push_back(tmp);
+  // accumulate statistics block by block so that memory usage does not
+  // depend on the number of input vectors
+  principal_component_analysis.Clear(&buffer);
+  sptk::Matrix block_of_input_vectors(kNumVectorInBlock, vector_length);
+  sptk::Matrix partial_block_of_input_vectors;
+  std::vector<double> input_vector(vector_length);
+  int num_vector_in_block(0);
+  int num_input_vector(0);
+  bool is_eof(false);
+  while (!is_eof) {
+    is_eof = !input_source.Get(&input_vector);
+    if (!is_eof) {
+      std::copy(input_vector.begin(), input_vector.end(),
+                block_of_input_vectors[num_vector_in_block]);
+      ++num_vector_in_block;
+      ++num_input_vector;
     }
-  }
-  if (input_vectors.empty()) return 0;
-
-  std::vector<double> mean_vector(vector_length);
-  std::vector<double> eigenvalues(vector_length);
-  sptk::Matrix eigenvector_matrix(vector_length, vector_length);
-  if (!principal_component_analysis.Run(input_vectors, &mean_vector,
-                                        &eigenvalues, &eigenvector_matrix,
-                                        &buffer)) {
-    std::ostringstream error_message;
-    error_message << "Failed to apply principal component analysis";
-    sptk::PrintErrorMessage("pca", error_message);
-    return 1;
-  }
-
-  if (!sptk::WriteStream(0, vector_length, mean_vector, &std::cout, NULL)) {
-    std::ostringstream error_message;
-    error_message << "Failed to write mean vector";
-    sptk::PrintErrorMessage("pca", error_message);
-    return 1;
-  }
-
-  sptk::Matrix eigenvector_submatrix;
-  if (!eigenvector_matrix.GetSubmatrix(0, num_principal_component, 0,
-                                       vector_length, &eigenvector_submatrix)) {
-    std::ostringstream error_message;
-    error_message << "Failed to get eigenvectors";
-    sptk::PrintErrorMessage("pca", error_message);
-    return 1;
-  }
-  if (!sptk::WriteStream(eigenvector_submatrix, &std::cout)) {
-    std::ostringstream error_message;
-    error_message << "Failed to write eigenvectors";
-    sptk::PrintErrorMessage("pca", error_message);
-    return 1;
-  }
 
-  if (NULL != eigenvalues_file) {
-    if (!sptk::WriteStream(0, num_principal_component, eigenvalues,
-                           &output_stream, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write eigenvalues";
-      sptk::PrintErrorMessage("pca", error_message);
-      return 1;
+    const bool is_output_time(
+        0 < num_input_vector &&
+        (is_eof ? (0 == output_interval ||
+                   0 != num_input_vector % output_interval)
+                : (0 < output_interval &&
+                   0 == num_input_vector % output_interval)));
+    if (kNumVectorInBlock == num_vector_in_block ||
+        (is_output_time && 0 < num_vector_in_block)) {
+      const bool is_full(kNumVectorInBlock == num_vector_in_block);
+      if (!is_full && !block_of_input_vectors.GetSubmatrix(
+                          0, num_vector_in_block, 0, vector_length,
+                          &partial_block_of_input_vectors)) {
+        std::ostringstream error_message;
+        error_message << "Failed to get input vectors";
+        sptk::PrintErrorMessage("pca", error_message);
+        return 1;
+      }
+      if (!principal_component_analysis.Run(
+              is_full ? block_of_input_vectors : partial_block_of_input_vectors,
+              &buffer)) {
+        std::ostringstream error_message;
+        error_message << "Failed to accumulate statistics";
+        sptk::PrintErrorMessage("pca", error_message);
+        return 1;
+      }
+      num_vector_in_block = 0;
     }
 
-    const double sum(
-        std::accumulate(eigenvalues.begin(), eigenvalues.end(), 0.0));
-    std::vector<double> proportions(num_principal_component);
-    std::transform(eigenvalues.begin(),
-                   eigenvalues.begin() + num_principal_component,
-                   proportions.begin(),
-                   std::bind1st(std::multiplies<double>(), 1.0 / sum));
-    if (!sptk::WriteStream(0, num_principal_component, proportions,
-                           &output_stream, NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write proportions";
-      sptk::PrintErrorMessage("pca", error_message);
-      return 1;
+    if (is_output_time) {
+      if (!OutputPrincipalComponents(
+              principal_component_analysis, vector_length,
+              num_principal_component,
+              NULL != eigenvalues_file ? &output_stream : NULL, &buffer)) {
+        std::ostringstream error_message;
+        error_message << "Failed to write principal components";
+        sptk::PrintErrorMessage("pca", error_message);
+        return 1;
+      }
     }
   }
 
@@ -47,6 +47,7 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "SPTK/math/matrix.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -55,6 +56,7 @@ namespace {
 
 const int kDefaultVectorLength(25);
 const int kDefaultNumPrincipalComponent(2);
+const int kNumVectorInBlock(256);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -189,6 +191,16 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  // Principal component scores of a block of input vectors are calculated at
+  // once by multiplying the block by the transposed eigenvector matrix.
+  sptk::Matrix transposed_eigenvector_matrix;
+  if (!eigenvector_matrix.Transpose(&transposed_eigenvector_matrix)) {
+    std::ostringstream error_message;
+    error_message << "Failed to transpose eigenvectors";
+    sptk::PrintErrorMessage("pcas", error_message);
+    return 1;
+  }
+
   // open stream
   std::ifstream ifs;
   ifs.open(input_file, std::ios::in | std::ios::binary);
@@ -200,15 +212,43 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  sptk::Matrix input_vector(vector_length, 1);
-  while (sptk::ReadStream(&input_vector, &input_stream)) {
-    if (!sptk::WriteStream(eigenvector_matrix * (input_vector - mean_vector),
-                           &std::cout)) {
+  std::vector<double> input_vectors(vector_length * kNumVectorInBlock);
+  sptk::Matrix input_block(kNumVectorInBlock, vector_length);
+  sptk::Matrix principal_component_scores;
+  int actual_read_size(0);
+  for (;;) {
+    actual_read_size = 0;
+    sptk::ReadStream(false, 0, 0, vector_length * kNumVectorInBlock,
+                     &input_vectors, &input_stream, &actual_read_size);
+    const int num_vector(actual_read_size / vector_length);
+    if (0 == num_vector) break;
+
+    if (num_vector != input_block.GetNumRow()) {
+      input_block.Resize(num_vector, vector_length);
+    }
+    for (int i(0), k(0); i < num_vector; ++i) {
+      double* row(input_block[i]);
+      for (int j(0); j < vector_length; ++j, ++k) {
+        row[j] = input_vectors[k] - mean_vector[j][0];
+      }
+    }
+
+    if (!input_block.Multiply(transposed_eigenvector_matrix,
+                              &principal_component_scores)) {
+      std::ostringstream error_message;
+      error_message << "Failed to calculate principal component scores";
+      sptk::PrintErrorMessage("pcas", error_message);
+      return 1;
+    }
+
+    if (!sptk::WriteStream(principal_component_scores, &std::cout)) {
       std::ostringstream error_message;
       error_message << "Failed to write principal component scores";
       sptk::PrintErrorMessage("pcas", error_message);
       return 1;
     }
+
+    if (num_vector < kNumVectorInBlock) break;
   }
 
   return 0;
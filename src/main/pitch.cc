@@ -51,6 +51,7 @@
 #include <sstream>
 #include <vector>
 
+#include "SPTK/analyzer/chunked_pitch_extraction.h"
 #include "SPTK/analyzer/pitch_extraction.h"
 #include "SPTK/utils/sptk_utils.h"
 
@@ -76,6 +77,8 @@ const double kDefaultVoicingThresholdForSwipe(0.3);
 const double kDefaultVoicingThresholdForReaper(0.9);
 const double kDefaultVoicingThresholdForWorld(0.1);
 const OutputFormats kDefaultOutputFormat(kPitch);
+const int kDefaultChunkLength(0);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -105,6 +108,8 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 0 (pitch)" << std::endl;
   *stream << "                 1 (F0)" << std::endl;
   *stream << "                 2 (log F0)" << std::endl;
+  *stream << "       -c c  : chunk length [frame]          (   int)[" << std::setw(5) << std::right << kDefaultChunkLength               << "][    0 <= c <=       ]" << std::endl;  // NOLINT
+  *stream << "       -j j  : number of threads             (   int)[" << std::setw(5) << std::right << kDefaultNumThread                 << "][    1 <= j <=       ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       waveform                              (double)[stdin]" << std::endl;  // NOLINT
@@ -113,12 +118,41 @@ void PrintUsage(std::ostream* stream) {
   *stream << "  notice:" << std::endl;
   *stream << "       if t is raised, the number of voiced frames will increase in RAPT, REAPER, and WORLD" << std::endl;  // NOLINT
   *stream << "       if t is dropped, the number of voiced frames will increase in SWIPE'" << std::endl;  // NOLINT
+  *stream << "       if c is 0, the whole waveform is processed at once" << std::endl;  // NOLINT
+  *stream << "       if c is greater than 0, the result of WORLD may slightly differ from that of c = 0" << std::endl;  // NOLINT
+  *stream << "       if c is greater than 0, REAPER cannot be used" << std::endl;  // NOLINT
+  *stream << "       -j is effective only if c is greater than 0, and RAPT does not run in parallel" << std::endl;  // NOLINT
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
   // clang-format on
 }
 
+void ConvertF0(OutputFormats output_format, double sampling_rate_in_hz,
+               std::vector<double>* f0) {
+  switch (output_format) {
+    case kPitch: {
+      std::transform(f0->begin(), f0->end(), f0->begin(),
+                     [sampling_rate_in_hz](double x) {
+                       return (0.0 < x) ? sampling_rate_in_hz / x : 0.0;
+                     });
+      break;
+    }
+    case kF0: {
+      // nothing to do
+      break;
+    }
+    case kLogF0: {
+      std::transform(f0->begin(), f0->end(), f0->begin(),
+                     [sampling_rate_in_hz](double x) {
+                       return (0.0 < x) ? std::log(x) : sptk::kLogZero;
+                     });
+      break;
+    }
+    default: { break; }
+  }
+}
+
 }  // namespace
 
 int main(int argc, char* argv[]) {
@@ -132,6 +166,8 @@ int main(int argc, char* argv[]) {
       kDefaultVoicingThresholdForReaper, kDefaultVoicingThresholdForWorld,
   };
   OutputFormats output_format(kDefaultOutputFormat);
+  int chunk_length(kDefaultChunkLength);
+  int num_thread(kDefaultNumThread);
 
   const struct option long_options[] = {
       {"t0", required_argument, NULL, kT0},
@@ -143,7 +179,7 @@ int main(int argc, char* argv[]) {
 
   for (;;) {
     const int option_char(
-        getopt_long_only(argc, argv, "a:p:s:L:H:o:h", long_options, NULL));
+        getopt_long_only(argc, argv, "a:p:s:L:H:o:c:j:h", long_options, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -285,6 +321,28 @@ int main(int argc, char* argv[]) {
         output_format = static_cast<OutputFormats>(tmp);
         break;
       }
+      case 'c': {
+        if (!sptk::ConvertStringToInteger(optarg, &chunk_length) ||
+            chunk_length < 0) {
+          std::ostringstream error_message;
+          error_message << "The argument for the -c option must be a "
+                        << "non-negative integer";
+          sptk::PrintErrorMessage("pitch", error_message);
+          return 1;
+        }
+        break;
+      }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("pitch", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -313,6 +371,13 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  if (0 < chunk_length && sptk::PitchExtraction::kReaper == algorithm) {
+    std::ostringstream error_message;
+    error_message << "REAPER cannot be used with the -c option";
+    sptk::PrintErrorMessage("pitch", error_message);
+    return 1;
+  }
+
   // get input file
   const int num_input_files(argc - optind);
   if (1 < num_input_files) {
@@ -334,6 +399,36 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
+  if (0 < chunk_length) {
+    sptk::ChunkedPitchExtraction chunked_pitch_extraction(
+        frame_shift, sampling_rate_in_hz, minimum_f0, maximum_f0,
+        voicing_thresholds[algorithm], algorithm, chunk_length, num_thread);
+    if (!chunked_pitch_extraction.IsValid()) {
+      std::ostringstream error_message;
+      error_message << "Failed to set condition for pitch extraction";
+      sptk::PrintErrorMessage("pitch", error_message);
+      return 1;
+    }
+
+    bool is_write_failed(false);
+    if (!chunked_pitch_extraction.Run(
+            [&](const std::vector<double>& f0) {
+              std::vector<double> output(f0);
+              ConvertF0(output_format, sampling_rate_in_hz, &output);
+              is_write_failed = !sptk::WriteStream(0, output.size(), output,
+                                                   &std::cout, NULL);
+              return !is_write_failed;
+            },
+            sptk::ChunkedPitchExtraction::EpochWriter(), &input_stream)) {
+      std::ostringstream error_message;
+      error_message << (is_write_failed ? "Failed to write pitch"
+                                        : "Failed to extract pitch");
+      sptk::PrintErrorMessage("pitch", error_message);
+      return 1;
+    }
+    return 0;
+  }
+
   // prepare for pitch extraction
   sptk::PitchExtraction pitch_extraction(
       frame_shift, sampling_rate_in_hz, minimum_f0, maximum_f0,
@@ -347,8 +442,9 @@ int main(int argc, char* argv[]) {
 
   std::vector<double> waveform;
   {
+    sptk::BufferedStreamReader reader(&input_stream);
     double tmp;
-    while (sptk::ReadStream(&tmp, &input_stream)) {
+    while (reader.Read(&tmp)) {
       waveform.push_back(tmp);
     }
   }
@@ -362,27 +458,7 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  switch (output_format) {
-    case kPitch: {
-      std::transform(f0.begin(), f0.end(), f0.begin(),
-                     [sampling_rate_in_hz](double x) {
-                       return (0.0 < x) ? sampling_rate_in_hz / x : 0.0;
-                     });
-      break;
-    }
-    case kF0: {
-      // nothing to do
-      break;
-    }
-    case kLogF0: {
-      std::transform(f0.begin(), f0.end(), f0.begin(),
-                     [sampling_rate_in_hz](double x) {
-                       return (0.0 < x) ? std::log(x) : sptk::kLogZero;
-                     });
-      break;
-    }
-    default: { break; }
-  }
+  ConvertF0(output_format, sampling_rate_in_hz, &f0);
 
   if (!sptk::WriteStream(0, f0.size(), f0, &std::cout, NULL)) {
     std::ostringstream error_message;
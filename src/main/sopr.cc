@@ -83,6 +83,8 @@ enum LongOptions {
   kMAGIC,
 };
 
+const int kBlockSize(4096);
+
 void PrintUsage(std::ostream* stream) {
   // clang-format off
   *stream << std::endl;
@@ -625,22 +627,48 @@ int main(int argc, char* argv[]) {
   }
   std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
-  double number;
-  while (sptk::ReadStream(&number, &input_stream)) {
-    bool is_magic_number;
-    if (!scalar_operation.Run(&number, &is_magic_number)) {
+  sptk::BufferedStreamReader reader(&input_stream);
+  sptk::BufferedStreamWriter writer(&std::cout);
+  std::vector<double> numbers(kBlockSize);
+  bool is_magic_numbers[kBlockSize];
+  for (;;) {
+    int block_size;
+    reader.Read(kBlockSize, &(numbers[0]), &block_size);
+    if (block_size <= 0) break;
+
+    if (!scalar_operation.Run(block_size, &(numbers[0]), is_magic_numbers)) {
       std::ostringstream error_message;
       error_message << "Failed to perform scalar operation";
       sptk::PrintErrorMessage("sopr", error_message);
       return 1;
     }
-    if (!is_magic_number && !sptk::WriteStream(number, &std::cout)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write data";
-      sptk::PrintErrorMessage("sopr", error_message);
-      return 1;
+
+    // write each run of numbers which are not magic numbers
+    for (int i(0); i < block_size;) {
+      if (is_magic_numbers[i]) {
+        ++i;
+        continue;
+      }
+      int end(i + 1);
+      while (end < block_size && !is_magic_numbers[end]) {
+        ++end;
+      }
+      if (!writer.Write(end - i, &(numbers[i]))) {
+        std::ostringstream error_message;
+        error_message << "Failed to write data";
+        sptk::PrintErrorMessage("sopr", error_message);
+        return 1;
+      }
+      i = end;
     }
   }
 
+  if (!writer.Flush()) {
+    std::ostringstream error_message;
+    error_message << "Failed to write data";
+    sptk::PrintErrorMessage("sopr", error_message);
+    return 1;
+  }
+
   return 0;
 }
@@ -43,13 +43,18 @@
 // ----------------------------------------------------------------- //
 
 #include <getopt.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <thread>
 #include <vector>
 
+#include "SPTK/input/input_source_from_mapped_file.h"
+#include "SPTK/input/input_source_from_stream.h"
+#include "SPTK/math/matrix.h"
 #include "SPTK/math/statistics_accumulator.h"
 #include "SPTK/math/symmetric_matrix.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -64,14 +69,19 @@ enum OutputFormats {
   kCorrelation,
   kPrecision,
   kMeanAndLowerAndUpperBounds,
+  kPartialStatistics,
   kNumOutputFormats
 };
 
 const int kMagicNumberForEndOfFile(-1);
+const int kNumVectorInBlock(256);
+const int kMaxNumElementInBlock(1 << 16);
 const int kDefaultVectorLength(1);
 const double kDefaultConfidenceLevel(95.0);
 const OutputFormats kDefaultOutputFormat(kMeanAndCovariance);
 const bool kDefaultOutputOnlyDiagonalElementsFlag(false);
+const bool kDefaultMergePartialStatisticsFlag(false);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -80,12 +90,13 @@ void PrintUsage(std::ostream* stream) {
   *stream << std::endl;
   *stream << "  usage:" << std::endl;
   *stream << "       vstat [ options ] [ infile ] > stdout" << std::endl;
+  *stream << "       vstat -r [ options ] [ infile1 infile2 ... ] > stdout" << std::endl;  // NOLINT
   *stream << "  options:" << std::endl;
   *stream << "       -l l  : length of vector     (   int)[" << std::setw(5) << std::right << kDefaultVectorLength    << "][ 1 <= l <=     ]" << std::endl;  // NOLINT
   *stream << "       -m m  : order of vector      (   int)[" << std::setw(5) << std::right << "l-1"                   << "][ 0 <= m <=     ]" << std::endl;  // NOLINT
   *stream << "       -t t  : output interval      (   int)[" << std::setw(5) << std::right << "EOF"                   << "][ 1 <= t <=     ]" << std::endl;  // NOLINT
   *stream << "       -c c  : confidence level     (double)[" << std::setw(5) << std::right << kDefaultConfidenceLevel << "][ 0 <  c <  100 ]" << std::endl;  // NOLINT
-  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat    << "][ 0 <= o <= 6   ]" << std::endl;  // NOLINT
+  *stream << "       -o o  : output format        (   int)[" << std::setw(5) << std::right << kDefaultOutputFormat    << "][ 0 <= o <= 7   ]" << std::endl;  // NOLINT
   *stream << "                 0 (mean and covariance)" << std::endl;
   *stream << "                 1 (mean)" << std::endl;
   *stream << "                 2 (covariance)" << std::endl;
@@ -93,13 +104,23 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 4 (correlation)" << std::endl;
   *stream << "                 5 (precision)" << std::endl;
   *stream << "                 6 (mean and lower/upper bounds)" << std::endl;
+  *stream << "                 7 (partial statistics)" << std::endl;
   *stream << "       -d    : output only diagonal (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultOutputOnlyDiagonalElementsFlag) << "]" << std::endl;  // NOLINT
   *stream << "               elements" << std::endl;
+  *stream << "       -r    : merge partial        (  bool)[" << std::setw(5) << std::right << sptk::ConvertBooleanToString(kDefaultMergePartialStatisticsFlag) << "]" << std::endl;  // NOLINT
+  *stream << "               statistics" << std::endl;
+  *stream << "       -j j  : number of threads    (   int)[" << std::setw(5) << std::right << kDefaultNumThread       << "][ 1 <= j <=     ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       vectors                      (double)[stdin]" << std::endl;
+  *stream << "       or partial statistics (-r)   (double)[stdin]" << std::endl;
   *stream << "  stdout:" << std::endl;
   *stream << "       statistics                   (double)" << std::endl;
+  *stream << "  notice:" << std::endl;
+  *stream << "       partial statistics consist of the number of vectors, the length of" << std::endl;  // NOLINT
+  *stream << "       vector, the sum, and the lower triangle of the sum of squared" << std::endl;  // NOLINT
+  *stream << "       deviations from the mean" << std::endl;
+  *stream << "       -t option cannot be used with -r option" << std::endl;
   *stream << std::endl;
   *stream << " SPTK: version " << sptk::kVersion << std::endl;
   *stream << std::endl;
@@ -199,6 +220,12 @@ bool OutputStatistics(const sptk::StatisticsAccumulator& accumulator,
     }
   }
 
+  if (kPartialStatistics == output_format) {
+    if (!accumulator.WriteStatistics(buffer, &std::cout)) {
+      return false;
+    }
+  }
+
   if (kMeanAndLowerAndUpperBounds == output_format) {
     int num_vector;
     if (!accumulator.GetNumData(buffer, &num_vector)) {
@@ -250,9 +277,12 @@ int main(int argc, char* argv[]) {
   double confidence_level(kDefaultConfidenceLevel);
   OutputFormats output_format(kDefaultOutputFormat);
   bool outputs_only_diagonal_elements(kDefaultOutputOnlyDiagonalElementsFlag);
+  bool merges_partial_statistics(kDefaultMergePartialStatisticsFlag);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:m:t:c:o:dh", NULL, NULL));
+    const int option_char(
+        getopt_long(argc, argv, "l:m:t:c:o:drj:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -320,6 +350,21 @@ int main(int argc, char* argv[]) {
         outputs_only_diagonal_elements = true;
         break;
       }
+      case 'r': {
+        merges_partial_statistics = true;
+        break;
+      }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -331,26 +376,21 @@ int main(int argc, char* argv[]) {
     }
   }
 
-  // get input file
+  // get input files
   const int num_input_files(argc - optind);
-  if (1 < num_input_files) {
+  if (!merges_partial_statistics && 1 < num_input_files) {
     std::ostringstream error_message;
     error_message << "Too many input files";
     sptk::PrintErrorMessage("vstat", error_message);
     return 1;
   }
-  const char* input_file(0 == num_input_files ? NULL : argv[optind]);
-
-  // open stream
-  std::ifstream ifs;
-  ifs.open(input_file, std::ios::in | std::ios::binary);
-  if (ifs.fail() && NULL != input_file) {
+  if (merges_partial_statistics &&
+      kMagicNumberForEndOfFile != output_interval) {
     std::ostringstream error_message;
-    error_message << "Cannot open file " << input_file;
+    error_message << "The -t option cannot be used with the -r option";
     sptk::PrintErrorMessage("vstat", error_message);
     return 1;
   }
-  std::istream& input_stream(ifs.fail() ? std::cin : ifs);
 
   sptk::StatisticsAccumulator accumulator(vector_length - 1, 2);
   sptk::StatisticsAccumulator::Buffer buffer;
@@ -361,27 +401,165 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::vector<double> data(vector_length);
-  for (int vector_index(1);
-       sptk::ReadStream(false, 0, 0, vector_length, &data, &input_stream, NULL);
-       ++vector_index) {
-    if (!accumulator.Run(data, &buffer)) {
-      std::ostringstream error_message;
-      error_message << "Failed to accumulate statistics";
-      sptk::PrintErrorMessage("vstat", error_message);
-      return 1;
+  if (merges_partial_statistics) {
+    sptk::StatisticsAccumulator::Buffer partial_buffer;
+    const int num_streams(0 == num_input_files ? 1 : num_input_files);
+    for (int i(0); i < num_streams; ++i) {
+      const char* input_file(0 == num_input_files ? NULL : argv[optind + i]);
+      std::ifstream ifs;
+      ifs.open(input_file, std::ios::in | std::ios::binary);
+      if (ifs.fail() && NULL != input_file) {
+        std::ostringstream error_message;
+        error_message << "Cannot open file " << input_file;
+        sptk::PrintErrorMessage("vstat", error_message);
+        return 1;
+      }
+      std::istream& input_stream(ifs.fail() ? std::cin : ifs);
+
+      for (;;) {
+        bool is_end_of_stream;
+        if (!accumulator.ReadStatistics(&input_stream, &partial_buffer,
+                                        &is_end_of_stream)) {
+          if (is_end_of_stream) break;
+          std::ostringstream error_message;
+          error_message << "Failed to read partial statistics";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        if (!accumulator.Merge(partial_buffer, &buffer)) {
+          std::ostringstream error_message;
+          error_message << "Failed to merge statistics";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+      }
     }
+  } else {
+    const char* input_file(0 == num_input_files ? NULL : argv[optind]);
 
-    if (kMagicNumberForEndOfFile != output_interval &&
-        0 == vector_index % output_interval) {
-      if (!OutputStatistics(accumulator, buffer, vector_length, output_format,
-                            confidence_level, outputs_only_diagonal_elements)) {
+    // open stream
+    sptk::InputSourceFromMappedFile input_source_from_file(
+        false, 0, vector_length, input_file);
+    std::ifstream ifs;
+    if (!input_source_from_file.IsValid()) {
+      ifs.open(input_file, std::ios::in | std::ios::binary);
+      if (ifs.fail() && NULL != input_file) {
         std::ostringstream error_message;
-        error_message << "Failed to write statistics";
+        error_message << "Cannot open file " << input_file;
         sptk::PrintErrorMessage("vstat", error_message);
         return 1;
       }
-      accumulator.Clear(&buffer);
+    }
+    std::istream& input_stream(ifs.is_open() ? ifs : std::cin);
+    sptk::InputSourceFromStream input_source_from_stream(false, vector_length,
+                                                         &input_stream);
+    sptk::InputSourceInterface& input_source(
+        input_source_from_file.IsValid()
+            ? static_cast<sptk::InputSourceInterface&>(input_source_from_file)
+            : input_source_from_stream);
+
+    // Each thread accumulates a large contiguous block of vectors into its own
+    // buffer. The first thread uses the main buffer, and the buffers of the
+    // other threads are merged into it once per output interval. The block
+    // size is a multiple of kNumVectorInBlock so that the result of a single
+    // thread does not depend on it.
+    const int max_block_size(
+        std::max(kNumVectorInBlock, kMaxNumElementInBlock / vector_length /
+                                        kNumVectorInBlock * kNumVectorInBlock));
+    std::vector<sptk::Matrix> blocks_of_vectors(num_thread);
+    std::vector<sptk::StatisticsAccumulator::Buffer> buffers(num_thread);
+    std::vector<int> is_succeeded(num_thread);
+    std::vector<double> data(vector_length);
+    for (int num_vector(0);;) {
+      // Read vectors block by block without crossing an output boundary.
+      int num_block(0);
+      bool is_end_of_input(false);
+      while (num_block < num_thread && num_vector != output_interval) {
+        int block_size(max_block_size);
+        if (kMagicNumberForEndOfFile != output_interval &&
+            output_interval - num_vector < block_size) {
+          block_size = output_interval - num_vector;
+        }
+        sptk::Matrix& block_of_vectors(blocks_of_vectors[num_block]);
+        if (block_of_vectors.GetNumRow() != block_size) {
+          block_of_vectors.Resize(block_size, vector_length);
+        }
+
+        int num_read_vector(0);
+        for (; num_read_vector < block_size && input_source.Get(&data);
+             ++num_read_vector) {
+          std::copy(data.begin(), data.end(),
+                    block_of_vectors[num_read_vector]);
+        }
+        if (num_read_vector < block_size) {
+          is_end_of_input = true;
+          if (0 == num_read_vector) break;
+          sptk::Matrix last_block_of_vectors;
+          if (!block_of_vectors.GetSubmatrix(0, num_read_vector, 0,
+                                             vector_length,
+                                             &last_block_of_vectors)) {
+            std::ostringstream error_message;
+            error_message << "Failed to accumulate statistics";
+            sptk::PrintErrorMessage("vstat", error_message);
+            return 1;
+          }
+          block_of_vectors = last_block_of_vectors;
+        }
+        num_vector += num_read_vector;
+        ++num_block;
+        if (is_end_of_input) break;
+      }
+
+      // The first block is processed by the main thread.
+      std::vector<std::thread> threads;
+      for (int t(1); t < num_block; ++t) {
+        threads.push_back(std::thread([&, t]() {
+          is_succeeded[t] =
+              accumulator.Run(blocks_of_vectors[t], &(buffers[t]));
+        }));
+      }
+      if (0 < num_block) {
+        is_succeeded[0] = accumulator.Run(blocks_of_vectors[0], &buffer);
+      }
+      for (std::vector<std::thread>::iterator itr(threads.begin());
+           itr != threads.end(); ++itr) {
+        itr->join();
+      }
+      for (int t(0); t < num_block; ++t) {
+        if (!is_succeeded[t]) {
+          std::ostringstream error_message;
+          error_message << "Failed to accumulate statistics";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+      }
+
+      if (num_vector == output_interval || is_end_of_input) {
+        for (int t(1); t < num_thread; ++t) {
+          if (!accumulator.Merge(buffers[t], &buffer)) {
+            std::ostringstream error_message;
+            error_message << "Failed to accumulate statistics";
+            sptk::PrintErrorMessage("vstat", error_message);
+            return 1;
+          }
+          accumulator.Clear(&(buffers[t]));
+        }
+      }
+
+      if (num_vector == output_interval) {
+        num_vector = 0;
+        if (!OutputStatistics(accumulator, buffer, vector_length,
+                              output_format, confidence_level,
+                              outputs_only_diagonal_elements)) {
+          std::ostringstream error_message;
+          error_message << "Failed to write statistics";
+          sptk::PrintErrorMessage("vstat", error_message);
+          return 1;
+        }
+        accumulator.Clear(&buffer);
+      }
+
+      if (is_end_of_input) break;
     }
   }
 
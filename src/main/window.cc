@@ -50,6 +50,7 @@
 #include <vector>
 
 #include "SPTK/utils/data_windowing.h"
+#include "SPTK/utils/parallel_frame_processing.h"
 #include "SPTK/utils/sptk_utils.h"
 
 namespace {
@@ -59,6 +60,7 @@ const sptk::DataWindowing::NormalizationType kDefaultNormalizationType(
     sptk::DataWindowing::NormalizationType::kPower);
 const sptk::DataWindowing::WindowType kDefaultWindowType(
     sptk::DataWindowing::WindowType::kBlackman);
+const int kDefaultNumThread(1);
 
 void PrintUsage(std::ostream* stream) {
   // clang-format off
@@ -82,6 +84,7 @@ void PrintUsage(std::ostream* stream) {
   *stream << "                 3 (Bartlett)" << std::endl;
   *stream << "                 4 (trapezoidal)" << std::endl;
   *stream << "                 5 (rectangular)" << std::endl;
+  *stream << "       -j j  : number of threads             (   int)[" << std::setw(5) << std::right << kDefaultNumThread         << "][ 1 <= j <=   ]" << std::endl;  // NOLINT
   *stream << "       -h    : print this message" << std::endl;
   *stream << "  infile:" << std::endl;
   *stream << "       data sequence                         (double)[stdin]" << std::endl;  // NOLINT
@@ -102,9 +105,10 @@ int main(int argc, char* argv[]) {
   sptk::DataWindowing::NormalizationType normalization_type(
       kDefaultNormalizationType);
   sptk::DataWindowing::WindowType window_type(kDefaultWindowType);
+  int num_thread(kDefaultNumThread);
 
   for (;;) {
-    const int option_char(getopt_long(argc, argv, "l:L:n:w:h", NULL, NULL));
+    const int option_char(getopt_long(argc, argv, "l:L:n:w:j:h", NULL, NULL));
     if (-1 == option_char) break;
 
     switch (option_char) {
@@ -166,6 +170,17 @@ int main(int argc, char* argv[]) {
         window_type = static_cast<sptk::DataWindowing::WindowType>(tmp);
         break;
       }
+      case 'j': {
+        if (!sptk::ConvertStringToInteger(optarg, &num_thread) ||
+            num_thread <= 0) {
+          std::ostringstream error_message;
+          error_message
+              << "The argument for the -j option must be a positive integer";
+          sptk::PrintErrorMessage("window", error_message);
+          return 1;
+        }
+        break;
+      }
       case 'h': {
         PrintUsage(&std::cout);
         return 0;
@@ -219,25 +234,31 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
-  std::vector<double> data_sequence(input_length);
-  std::vector<double> windowed_data_sequence(output_length);
-
-  while (sptk::ReadStream(false, 0, 0, input_length, &data_sequence,
-                          &input_stream, NULL)) {
-    if (!data_windowing.Run(data_sequence, &windowed_data_sequence)) {
-      std::ostringstream error_message;
-      error_message << "Failed to apply a window function";
-      sptk::PrintErrorMessage("window", error_message);
-      return 1;
-    }
+  sptk::ParallelFrameProcessing parallel_frame_processing(
+      input_length, output_length, num_thread, false);
+  if (!parallel_frame_processing.IsValid()) {
+    std::ostringstream error_message;
+    error_message << "Failed to set condition for parallel processing";
+    sptk::PrintErrorMessage("window", error_message);
+    return 1;
+  }
 
-    if (!sptk::WriteStream(0, output_length, windowed_data_sequence, &std::cout,
-                           NULL)) {
-      std::ostringstream error_message;
-      error_message << "Failed to write windowed data sequence";
-      sptk::PrintErrorMessage("window", error_message);
-      return 1;
-    }
+  // DataWindowing has no buffer, so it is shared by all threads
+  if (!parallel_frame_processing.Run(
+          [&data_windowing](const std::vector<double>& data_sequence,
+                            std::vector<double>* windowed_data_sequence,
+                            int thread_index) {
+            return data_windowing.Run(data_sequence, windowed_data_sequence);
+          },
+          [output_length](const std::vector<double>& windowed_data_sequence) {
+            return sptk::WriteStream(0, output_length, windowed_data_sequence,
+                                     &std::cout, NULL);
+          },
+          &input_stream)) {
+    std::ostringstream error_message;
+    error_message << "Failed to apply a window function";
+    sptk::PrintErrorMessage("window", error_message);
+    return 1;
   }
 
   return 0;
@@ -50,7 +50,7 @@
 #include <iomanip>
 #include <iostream>
 #include <sstream>
-#include <stdexcept>
+#include <vector>
 
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/sptk_utils.h"
@@ -68,6 +68,7 @@ enum NumericType {
 enum WarningType { kIgnore = 0, kWarn, kExit, kNumWarningTypes };
 
 const int kBufferSize(128);
+const int kBlockSize(4096);
 const char* kDefaultDataTypes("da");
 const bool kDefaultRoundingFlag(false);
 const WarningType kDefaultWarningType(kIgnore);
@@ -110,6 +111,86 @@ void PrintUsage(std::ostream* stream) {
   // clang-format on
 }
 
+// Type in which input values are compared with the range of output type.
+// Floating-point values are compared in double, which is exact unless the
+// bounds of output type are 64-bit integers.
+template <typename T>
+struct ComparisonType {
+  typedef int64_t Type;
+};
+
+template <>
+struct ComparisonType<uint8_t> {
+  typedef uint64_t Type;
+};
+
+template <>
+struct ComparisonType<uint16_t> {
+  typedef uint64_t Type;
+};
+
+template <>
+struct ComparisonType<sptk::uint24_t> {
+  typedef uint64_t Type;
+};
+
+template <>
+struct ComparisonType<uint32_t> {
+  typedef uint64_t Type;
+};
+
+template <>
+struct ComparisonType<uint64_t> {
+  typedef uint64_t Type;
+};
+
+template <>
+struct ComparisonType<float> {
+  typedef double Type;
+};
+
+template <>
+struct ComparisonType<double> {
+  typedef double Type;
+};
+
+template <>
+struct ComparisonType<long double> {
+  typedef long double Type;
+};
+
+// Check whether a binary-to-binary transform can be done block by block with
+// the same result as the element-wise one.
+template <typename T1, typename T2>
+struct IsBlockTransformable {
+  static const bool kValue = true;
+};
+
+template <typename T2>
+struct IsBlockTransformable<long double, T2> {
+  static const bool kValue = false;
+};
+
+template <>
+struct IsBlockTransformable<float, int64_t> {
+  static const bool kValue = false;
+};
+
+template <>
+struct IsBlockTransformable<float, uint64_t> {
+  static const bool kValue = false;
+};
+
+template <>
+struct IsBlockTransformable<double, int64_t> {
+  static const bool kValue = false;
+};
+
+template <>
+struct IsBlockTransformable<double, uint64_t> {
+  static const bool kValue = false;
+};
+
 class DataTransformInterface {
  public:
   virtual ~DataTransformInterface() {
@@ -139,22 +220,28 @@ class DataTransform : public DataTransformInterface {
   }
 
   virtual bool Run(std::istream* input_stream) const {
+    if (!is_ascii_input_ && !is_ascii_output_ &&
+        IsBlockTransformable<T1, T2>::kValue) {
+      return RunBlockTransform(input_stream);
+    }
+
     char buffer[kBufferSize];
+    std::string word;
+    sptk::BufferedStreamReader reader(input_stream);
+    sptk::BufferedStreamWriter writer(&std::cout);
     int index(0);
     for (;; ++index) {
       // read
       T1 input_data;
       if (is_ascii_input_) {
-        std::string word;
-        *input_stream >> word;
-        if (word.empty()) break;
-        try {
-          input_data = std::stold(word);
-        } catch (std::invalid_argument) {
+        if (!reader.ReadWord(&word)) break;
+        long double converted_data;
+        if (!sptk::ConvertLeadingStringToLongDouble(word, &converted_data)) {
           return false;
         }
+        input_data = converted_data;
       } else {
-        if (!sptk::ReadStream(&input_data, input_stream)) {
+        if (!reader.Read(&input_data)) {
           break;
         }
       }
@@ -221,27 +308,127 @@ class DataTransform : public DataTransformInterface {
                             buffer)) {
           return false;
         }
-        std::cout << buffer;
-        if (0 == (index + 1) % num_column_) {
-          std::cout << std::endl;
-        } else {
-          std::cout << "\t";
+        if (!writer.WriteString(buffer) ||
+            !writer.Write(0 == (index + 1) % num_column_ ? '\n' : '\t')) {
+          return false;
         }
       } else {
-        if (!sptk::WriteStream(output_data, &std::cout)) {
+        if (!writer.Write(output_data)) {
           return false;
         }
       }
     }
 
     if (is_ascii_output_ && 0 != index % num_column_) {
-      std::cout << std::endl;
+      if (!writer.Write('\n')) {
+        return false;
+      }
     }
 
-    return true;
+    return writer.Flush();
   }
 
  private:
+  // Transform binary data block by block. The loop over a block has no
+  // branches, and clipped values are only counted. The indices of clipped
+  // values are searched for afterwards only if a warning is required.
+  bool RunBlockTransform(std::istream* input_stream) const {
+    sptk::BufferedStreamReader reader(input_stream);
+    sptk::BufferedStreamWriter writer(&std::cout);
+    std::vector<T1> input_block(kBlockSize);
+    std::vector<T2> output_block(kBlockSize);
+    const bool clipping(minimum_value_ < maximum_value_);
+
+    for (int index(0);;) {
+      int block_size;
+      reader.Read(kBlockSize, &(input_block[0]), &block_size);
+      if (block_size <= 0) break;
+
+      int num_clipped_data;
+      if (clipping) {
+        num_clipped_data =
+            rounding_
+                ? TransformBlock<true, true>(block_size, &(input_block[0]),
+                                             &(output_block[0]))
+                : TransformBlock<true, false>(block_size, &(input_block[0]),
+                                              &(output_block[0]));
+      } else {
+        num_clipped_data =
+            rounding_
+                ? TransformBlock<false, true>(block_size, &(input_block[0]),
+                                              &(output_block[0]))
+                : TransformBlock<false, false>(block_size, &(input_block[0]),
+                                               &(output_block[0]));
+      }
+
+      int num_output_data(block_size);
+      if (0 < num_clipped_data && kIgnore != warning_type_) {
+        for (int i(0); i < block_size; ++i) {
+          if (IsClipped(input_block[i])) {
+            std::ostringstream error_message;
+            error_message << index + i
+                          << "th data is over the range of output type";
+            sptk::PrintErrorMessage("x2x", error_message);
+            if (kExit == warning_type_) {
+              num_output_data = i;
+              break;
+            }
+          }
+        }
+      }
+
+      if (0 < num_output_data &&
+          !writer.Write(num_output_data, &(output_block[0]))) {
+        return false;
+      }
+      if (num_output_data < block_size) {
+        return false;
+      }
+      index += block_size;
+    }
+
+    return writer.Flush();
+  }
+
+  // Transform a block and return the number of clipped values. Clipping and
+  // rounding are done by selection so that the compiler can vectorize the
+  // loop for most pairs of types.
+  template <bool kClipping, bool kRounding>
+  int TransformBlock(int block_size, const T1* input, T2* output) const {
+    typedef typename ComparisonType<T1>::Type C;
+    if (!kClipping && !kRounding) {
+      for (int i(0); i < block_size; ++i) {
+        output[i] = T2(input[i]);
+      }
+      return 0;
+    }
+
+    const C lower_bound(static_cast<C>(minimum_value_));
+    const C upper_bound(static_cast<C>(maximum_value_));
+    int num_clipped_data(0);
+    for (int i(0); i < block_size; ++i) {
+      const C x(static_cast<C>(input[i]));
+      C y(x);
+      if (kRounding) {
+        y += (0.0 < x) ? 0.5 : -0.5;
+      }
+      if (kClipping) {
+        num_clipped_data += (x < lower_bound) | (upper_bound < x);
+        // A value rounded off at the bounds is also truncated to the bounds.
+        y = (y < lower_bound) ? lower_bound : y;
+        y = (upper_bound < y) ? upper_bound : y;
+      }
+      output[i] = static_cast<T2>(y);
+    }
+    return num_clipped_data;
+  }
+
+  bool IsClipped(const T1& input_data) const {
+    typedef typename ComparisonType<T1>::Type C;
+    return (static_cast<C>(input_data) < static_cast<C>(minimum_value_) ||
+            static_cast<C>(maximum_value_) < static_cast<C>(input_data));
+  }
+
   const std::string print_format_;
   const int num_column_;
   const NumericType input_numeric_type_;
@@ -0,0 +1,375 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+#include "SPTK/math/cholesky_decomposition.h"
+
+#include <algorithm>  // std::fill, std::min
+#include <cstddef>    // std::size_t
+
+namespace {
+
+// The number of matrices interleaved in the batch inversion.
+const int kNumMatrixInBatch(32);
+
+}  // namespace
+
+namespace sptk {
+
+CholeskyDecomposition::CholeskyDecomposition(int num_order)
+    : num_order_(num_order), is_valid_(true) {
+  if (num_order_ < 0) {
+    is_valid_ = false;
+  }
+}
+
+bool CholeskyDecomposition::Run(const SymmetricMatrix& matrix,
+                                CholeskyDecomposition::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+  if (!is_valid_ || matrix.GetNumDimension() != length || NULL == buffer) {
+    return false;
+  }
+
+  // prepare memory
+  SymmetricMatrix& lower_triangular_matrix(buffer->lower_triangular_matrix_);
+  if (lower_triangular_matrix.GetNumDimension() != length) {
+    lower_triangular_matrix.Resize(length);
+  }
+  if (buffer->inverse_diagonal_elements_.size() !=
+      static_cast<std::size_t>(length)) {
+    buffer->inverse_diagonal_elements_.resize(length);
+  }
+  if (buffer->work_.size() < static_cast<std::size_t>(length)) {
+    buffer->work_.resize(length);
+  }
+
+  // The i-th row of L is computed from the preceding rows. All loops read
+  // rows of the packed storage sequentially.
+  double* inverse_d(&(buffer->inverse_diagonal_elements_[0]));
+  double* u(&(buffer->work_[0]));
+  for (int i(0); i < length; ++i) {
+    const double* a_i(matrix.index_[i]);
+    double* l_i(lower_triangular_matrix.index_[i]);
+    for (int j(0); j < i; ++j) {
+      const double* l_j(lower_triangular_matrix.index_[j]);
+      double sum(a_i[j]);
+      for (int k(0); k < j; ++k) {
+        sum -= u[k] * l_j[k];
+      }
+      u[j] = sum;  // l_i[j] * d[j]
+      l_i[j] = sum * inverse_d[j];
+    }
+
+    double d(a_i[i]);
+    for (int k(0); k < i; ++k) {
+      d -= u[k] * l_i[k];
+    }
+    if (0.0 == d) {
+      return false;
+    }
+    inverse_d[i] = 1.0 / d;
+    l_i[i] = 1.0;
+  }
+
+  return true;
+}
+
+bool CholeskyDecomposition::Solve(const CholeskyDecomposition::Buffer& buffer,
+                                  const std::vector<double>& constant_vector,
+                                  std::vector<double>* solution_vector) const {
+  const int length(num_order_ + 1);
+  if (!is_valid_ ||
+      buffer.lower_triangular_matrix_.GetNumDimension() != length ||
+      constant_vector.size() != static_cast<std::size_t>(length) ||
+      NULL == solution_vector) {
+    return false;
+  }
+
+  if (solution_vector->size() != static_cast<std::size_t>(length)) {
+    solution_vector->resize(length);
+  }
+
+  const SymmetricMatrix& lower_triangular_matrix(
+      buffer.lower_triangular_matrix_);
+  const double* inverse_d(&(buffer.inverse_diagonal_elements_[0]));
+  const double* b(&(constant_vector[0]));
+  double* x(&((*solution_vector)[0]));
+
+  // solve L y = b
+  for (int i(0); i < length; ++i) {
+    const double* l_i(lower_triangular_matrix.index_[i]);
+    double sum(b[i]);
+    for (int k(0); k < i; ++k) {
+      sum -= l_i[k] * x[k];
+    }
+    x[i] = sum;
+  }
+
+  // solve D z = y
+  for (int i(0); i < length; ++i) {
+    x[i] *= inverse_d[i];
+  }
+
+  // solve L^T x = z
+  for (int k(length - 1); 0 < k; --k) {
+    const double* l_k(lower_triangular_matrix.index_[k]);
+    const double x_k(x[k]);
+    for (int i(0); i < k; ++i) {
+      x[i] -= l_k[i] * x_k;
+    }
+  }
+
+  return true;
+}
+
+bool CholeskyDecomposition::Invert(const CholeskyDecomposition::Buffer& buffer,
+                                   SymmetricMatrix* inverse_matrix) const {
+  const int length(num_order_ + 1);
+  if (!is_valid_ ||
+      buffer.lower_triangular_matrix_.GetNumDimension() != length ||
+      NULL == inverse_matrix) {
+    return false;
+  }
+
+  if (inverse_matrix->GetNumDimension() != length) {
+    inverse_matrix->Resize(length);
+  }
+
+  // compute M = L^{-1}, which is also unit lower triangular
+  std::vector<double> m(length * (length + 1) / 2);
+  const SymmetricMatrix& lower_triangular_matrix(
+      buffer.lower_triangular_matrix_);
+  for (int i(0), offset_i(0); i < length; ++i, offset_i += i) {
+    const double* l_i(lower_triangular_matrix.index_[i]);
+    double* m_i(&(m[offset_i]));
+    for (int k(0), offset_k(0); k < i; ++k, offset_k += k) {
+      const double* m_k(&(m[offset_k]));
+      const double l_ik(l_i[k]);
+      m_i[k] = 0.0;
+      for (int j(0); j <= k; ++j) {
+        m_i[j] -= l_ik * m_k[j];
+      }
+    }
+    m_i[i] = 1.0;
+  }
+
+  // compute A^{-1} = M^T D^{-1} M as a sum of rank-one matrices
+  inverse_matrix->FillZero();
+  const double* inverse_d(&(buffer.inverse_diagonal_elements_[0]));
+  for (int k(0), offset_k(0); k < length; ++k, offset_k += k) {
+    const double* m_k(&(m[offset_k]));
+    for (int i(0); i <= k; ++i) {
+      const double c(m_k[i] * inverse_d[k]);
+      double* x_i(inverse_matrix->index_[i]);
+      for (int j(0); j <= i; ++j) {
+        x_i[j] += c * m_k[j];
+      }
+    }
+  }
+
+  return true;
+}
+
+bool CholeskyDecomposition::Invert(
+    const std::vector<SymmetricMatrix>& matrices,
+    std::vector<SymmetricMatrix>* inverse_matrices,
+    CholeskyDecomposition::Buffer* buffer) const {
+  if (!is_valid_ || NULL == inverse_matrices || NULL == buffer) {
+    return false;
+  }
+
+  const int length(num_order_ + 1);
+  const int num_matrix(matrices.size());
+  for (int n(0); n < num_matrix; ++n) {
+    if (matrices[n].GetNumDimension() != length) {
+      return false;
+    }
+  }
+
+  // prepare memory
+  if (inverse_matrices->size() != static_cast<std::size_t>(num_matrix)) {
+    inverse_matrices->resize(num_matrix);
+  }
+  for (int n(0); n < num_matrix; ++n) {
+    if ((*inverse_matrices)[n].GetNumDimension() != length) {
+      (*inverse_matrices)[n].Resize(length);
+    }
+  }
+  const int num_element(length * (length + 1) / 2);
+  buffer->interleaved_matrices_.resize(num_element * kNumMatrixInBatch);
+  buffer->interleaved_inverse_matrices_.resize(num_element *
+                                               kNumMatrixInBatch);
+  buffer->interleaved_inverse_diagonal_elements_.resize(length *
+                                                        kNumMatrixInBatch);
+  buffer->interleaved_work_.resize(length * kNumMatrixInBatch);
+
+  // The e-th element of the b-th matrix is stored in a[e * B + b], where B is
+  // the number of matrices in a batch. The algorithm is the same as in Run
+  // and Invert for a single matrix.
+  const int batch(kNumMatrixInBatch);
+  double* a(&(buffer->interleaved_matrices_[0]));
+  double* x(&(buffer->interleaved_inverse_matrices_[0]));
+  double* inverse_d(&(buffer->interleaved_inverse_diagonal_elements_[0]));
+  double* u(&(buffer->interleaved_work_[0]));
+  double sum[kNumMatrixInBatch];
+  for (int begin(0); begin < num_matrix; begin += batch) {
+    const int batch_size(std::min(batch, num_matrix - begin));
+
+    for (int b(0); b < batch_size; ++b) {
+      const double* data(matrices[begin + b].index_[0]);
+      for (int e(0); e < num_element; ++e) {
+        a[e * batch + b] = data[e];
+      }
+    }
+
+    // Unused slots are filled with identity matrices so that all loops have
+    // the same constant trip count, which the compiler can vectorize.
+    for (int b(batch_size); b < batch; ++b) {
+      for (int i(0), e(0); i < length; ++i) {
+        for (int j(0); j <= i; ++j, ++e) {
+          a[e * batch + b] = (i == j) ? 1.0 : 0.0;
+        }
+      }
+    }
+
+    // decompose A into L D L^T in place
+    for (int i(0), offset_i(0); i < length; ++i, offset_i += i) {
+      double* l_i(a + offset_i * batch);
+      for (int j(0), offset_j(0); j < i; ++j, offset_j += j) {
+        const double* l_j(a + offset_j * batch);
+        double* l_ij(l_i + j * batch);
+        for (int b(0); b < batch; ++b) {
+          sum[b] = l_ij[b];
+        }
+        for (int k(0); k < j; ++k) {
+          const double* u_k(u + k * batch);
+          const double* l_jk(l_j + k * batch);
+          for (int b(0); b < batch; ++b) {
+            sum[b] -= u_k[b] * l_jk[b];
+          }
+        }
+        double* u_j(u + j * batch);
+        const double* inverse_d_j(inverse_d + j * batch);
+        for (int b(0); b < batch; ++b) {
+          u_j[b] = sum[b];
+          l_ij[b] = sum[b] * inverse_d_j[b];
+        }
+      }
+
+      double* l_ii(l_i + i * batch);
+      for (int b(0); b < batch; ++b) {
+        sum[b] = l_ii[b];
+      }
+      for (int k(0); k < i; ++k) {
+        const double* u_k(u + k * batch);
+        const double* l_ik(l_i + k * batch);
+        for (int b(0); b < batch; ++b) {
+          sum[b] -= u_k[b] * l_ik[b];
+        }
+      }
+      double* inverse_d_i(inverse_d + i * batch);
+      for (int b(0); b < batch; ++b) {
+        if (0.0 == sum[b]) {
+          return false;
+        }
+        inverse_d_i[b] = 1.0 / sum[b];
+        l_ii[b] = 1.0;
+      }
+    }
+
+    // overwrite L with M = L^{-1}; the j-th column of the i-th row needs only
+    // the elements of L on its right, so they are computed from left to right
+    for (int i(0), offset_i(0); i < length; ++i, offset_i += i) {
+      double* m_i(a + offset_i * batch);
+      for (int j(0); j < i; ++j) {
+        double* m_ij(m_i + j * batch);
+        for (int b(0); b < batch; ++b) {
+          sum[b] = m_ij[b];
+        }
+        for (int k(j + 1), offset_k((j + 1) * (j + 2) / 2); k < i;
+             ++k, offset_k += k) {
+          const double* l_ik(m_i + k * batch);
+          const double* m_kj(a + (offset_k + j) * batch);
+          for (int b(0); b < batch; ++b) {
+            sum[b] += l_ik[b] * m_kj[b];
+          }
+        }
+        for (int b(0); b < batch; ++b) {
+          m_ij[b] = -sum[b];
+        }
+      }
+    }
+
+    // compute A^{-1} = M^T D^{-1} M
+    for (int i(0), offset_i(0); i < length; ++i, offset_i += i) {
+      double* x_i(x + offset_i * batch);
+      for (int j(0); j <= i; ++j) {
+        for (int b(0); b < batch; ++b) {
+          sum[b] = 0.0;
+        }
+        for (int k(i), offset_k(offset_i); k < length; ++k, offset_k += k) {
+          const double* m_ki(a + (offset_k + i) * batch);
+          const double* m_kj(a + (offset_k + j) * batch);
+          const double* inverse_d_k(inverse_d + k * batch);
+          for (int b(0); b < batch; ++b) {
+            sum[b] += m_ki[b] * inverse_d_k[b] * m_kj[b];
+          }
+        }
+        double* x_ij(x_i + j * batch);
+        for (int b(0); b < batch; ++b) {
+          x_ij[b] = sum[b];
+        }
+      }
+    }
+
+    for (int b(0); b < batch_size; ++b) {
+      double* data((*inverse_matrices)[begin + b].index_[0]);
+      for (int e(0); e < num_element; ++e) {
+        data[e] = x[e * batch + b];
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace sptk
@@ -44,33 +44,74 @@
 
 #include "SPTK/math/dynamic_time_warping.h"
 
-#include <algorithm>  // std::reverse
+#include <algorithm>  // std::max, std::min, std::reverse
 #include <cfloat>     // DBL_MAX
-
-namespace {
-
-struct Cell {
-  double score;
-  int horizontal_back_pointer;
-  int vertical_back_pointer;
-};
-
-}  // namespace
+#include <cmath>      // std::ceil, std::floor
+#include <cstddef>    // std::size_t
 
 namespace sptk {
 
 DynamicTimeWarping::DynamicTimeWarping(
     int num_order, LocalPathConstraints local_path_constraint,
     DistanceCalculator::DistanceMetrics distance_metric)
+    : DynamicTimeWarping(num_order, local_path_constraint, distance_metric,
+                         kNone, 0.0) {
+}
+
+DynamicTimeWarping::DynamicTimeWarping(
+    int num_order, LocalPathConstraints local_path_constraint,
+    DistanceCalculator::DistanceMetrics distance_metric,
+    GlobalPathConstraints global_path_constraint,
+    double global_path_constraint_parameter)
+    : DynamicTimeWarping(num_order, local_path_constraint, distance_metric,
+                         global_path_constraint,
+                         global_path_constraint_parameter, 0) {
+}
+
+DynamicTimeWarping::DynamicTimeWarping(
+    int num_order, LocalPathConstraints local_path_constraint,
+    DistanceCalculator::DistanceMetrics distance_metric,
+    GlobalPathConstraints global_path_constraint,
+    double global_path_constraint_parameter, std::size_t maximum_memory_size)
     : num_order_(num_order),
       local_path_constraint_(local_path_constraint),
+      global_path_constraint_(global_path_constraint),
+      global_path_constraint_parameter_(global_path_constraint_parameter),
       distance_calculator_(num_order_, distance_metric),
-      is_valid_(true) {
+      maximum_memory_size_(maximum_memory_size),
+      is_valid_(true),
+      num_rolling_rows_(0),
+      includes_skip_transition_(kType5 == local_path_constraint_ ||
+                                kType7 == local_path_constraint_) {
   if (num_order_ < 0 || !distance_calculator_.IsValid()) {
     is_valid_ = false;
     return;
   }
 
+  switch (global_path_constraint_) {
+    case kNone: {
+      break;
+    }
+    case kSakoeChibaBand: {
+      if (global_path_constraint_parameter_ < 0.0) {
+        is_valid_ = false;
+        return;
+      }
+      break;
+    }
+    case kItakuraParallelogram: {
+      if (global_path_constraint_parameter_ < 1.0) {
+        is_valid_ = false;
+        return;
+      }
+      break;
+    }
+    default: {
+      is_valid_ = false;
+      return;
+    }
+  }
+
   switch (local_path_constraint_) {
     case kType1: {
       local_path_candidates_.push_back(std::make_pair(1, 0));
@@ -123,6 +164,56 @@ DynamicTimeWarping::DynamicTimeWarping(
   for (int k(0); k < num_candidate; ++k) {
     local_path_weights_[k] =
         local_path_candidates_[k].first + local_path_candidates_[k].second;
+    num_rolling_rows_ =
+        std::max(num_rolling_rows_, local_path_candidates_[k].first + 1);
+  }
+}
+
+void DynamicTimeWarping::CalculateRangeOfReference(
+    int num_query_vector, int num_reference_vector, std::vector<int>* begin,
+    std::vector<int>* end) const {
+  begin->resize(num_query_vector);
+  end->resize(num_query_vector);
+
+  // Cell (i, j) is regarded as the unit square [i, i+1] x [j, j+1], and it is
+  // evaluated if the square touches the constrained region spanned from (0, 0)
+  // to (I, J). Thus the first and last cells and their neighbors on the axes
+  // are always included, and a loose constraint reproduces the unconstrained
+  // case.
+  const int last_i(num_query_vector - 1);
+  const int last_j(num_reference_vector - 1);
+  const double ratio(static_cast<double>(num_reference_vector) /
+                     num_query_vector);
+  for (int i(0); i < num_query_vector; ++i) {
+    double lower_bound, upper_bound;
+    switch (global_path_constraint_) {
+      case kSakoeChibaBand: {
+        // The band is centered on the diagonal of the whole region.
+        const double width(global_path_constraint_parameter_);
+        lower_bound = i * ratio - width - 1.0;
+        upper_bound = (i + 1) * ratio + width;
+        break;
+      }
+      case kItakuraParallelogram: {
+        const double slope(global_path_constraint_parameter_);
+        lower_bound =
+            std::max(i / slope - 1.0, last_j - slope * (last_i + 1 - i));
+        upper_bound =
+            std::min(slope * (i + 1), last_j + 1.0 - (last_i - i) / slope);
+        break;
+      }
+      default: {
+        lower_bound = 0.0;
+        upper_bound = last_j;
+        break;
+      }
+    }
+
+    lower_bound = std::max(0.0, lower_bound);
+    upper_bound = std::min(static_cast<double>(last_j), upper_bound);
+    (*begin)[i] = static_cast<int>(std::ceil(lower_bound));
+    (*end)[i] = static_cast<int>(std::floor(upper_bound)) + 1;
+    if ((*end)[i] < (*begin)[i]) (*end)[i] = (*begin)[i];
   }
 }
 
@@ -133,27 +224,108 @@ bool DynamicTimeWarping::Run(
     double* total_score) const {
   // check inputs
   if (!is_valid_ || query_vector_sequence.empty() ||
-      reference_vector_sequence.empty() || NULL == viterbi_path ||
-      NULL == total_score) {
+      reference_vector_sequence.empty() || NULL == total_score) {
     return false;
   }
 
-  const int num_candidate(local_path_candidates_.size());
   const int num_query_vector(query_vector_sequence.size());
   const int num_reference_vector(reference_vector_sequence.size());
 
-  std::vector<std::vector<Cell> > cell(num_query_vector,
-                                       std::vector<Cell>(num_reference_vector));
-  std::vector<std::vector<Cell> > cell_for_skip_transition(
-      num_query_vector, std::vector<Cell>(num_reference_vector));
+  // Cells (i, j) with begin[i] <= j < end[i] are evaluated.
+  std::vector<int> begin, end;
+  CalculateRangeOfReference(num_query_vector, num_reference_vector, &begin,
+                            &end);
 
-  const bool includes_skip_transition(
-      (kType5 == local_path_constraint_ || kType7 == local_path_constraint_)
-          ? true
-          : false);
+  const std::pair<int, int> first_cell(0, 0);
+  const std::pair<int, int> last_cell(num_query_vector - 1,
+                                      num_reference_vector - 1);
 
-  for (int i(0); i < num_query_vector; ++i) {
-    for (int j(0); j < num_reference_vector; ++j) {
+  bool is_divided(false);
+  if (NULL != viterbi_path) {
+    viterbi_path->clear();
+    if (0 < maximum_memory_size_) {
+      std::size_t num_cell(0);
+      for (int i(0); i < num_query_vector; ++i) {
+        num_cell += end[i] - begin[i];
+      }
+      is_divided = (maximum_memory_size_ <
+                    num_cell * (includes_skip_transition_ ? 2 : 1));
+    }
+  }
+
+  double score;
+  if (is_divided) {
+    if (!FindViterbiPathByDivideAndConquer(
+            query_vector_sequence, reference_vector_sequence, begin, end,
+            first_cell, last_cell, false, false, viterbi_path, &score)) {
+      return false;
+    }
+  } else {
+    if (!FindViterbiPath(query_vector_sequence, reference_vector_sequence,
+                         begin, end, first_cell, last_cell, false, false,
+                         viterbi_path, &score)) {
+      return false;
+    }
+  }
+
+  *total_score = score / (num_query_vector + num_reference_vector);
+
+  return true;
+}
+
+bool DynamicTimeWarping::CalculateForwardScores(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    const std::vector<int>& begin, const std::vector<int>& end,
+    const std::pair<int, int>& first_cell, int last_j,
+    bool is_first_entered_diagonally, int begin_i, int end_i,
+    std::vector<std::vector<double> >* scores,
+    std::vector<std::vector<double> >* scores_for_skip_transition,
+    std::vector<std::size_t>* offsets, std::vector<signed char>* back_pointers,
+    std::vector<signed char>* back_pointers_for_skip_transition) const {
+  const int num_candidate(local_path_candidates_.size());
+  const int first_i(first_cell.first);
+  const int first_j(first_cell.second);
+
+  // Scores are kept only in the rows which can be reached by local paths.
+  if (first_i == begin_i) {
+    const int width(last_j - first_j + 1);
+    scores->assign(num_rolling_rows_, std::vector<double>(width));
+    scores_for_skip_transition->assign(
+        includes_skip_transition_ ? num_rolling_rows_ : 0,
+        std::vector<double>(width));
+  }
+
+  // Back pointers are stored as indices of local path candidates within the
+  // global path constraint.
+  const bool stores_back_pointers(NULL != back_pointers);
+  if (stores_back_pointers) {
+    if (first_i != begin_i) {
+      return false;
+    }
+    offsets->resize(end_i - first_i + 1);
+    (*offsets)[0] = 0;
+    for (int i(first_i); i < end_i; ++i) {
+      (*offsets)[i - first_i + 1] =
+          (*offsets)[i - first_i] +
+          std::max(0, std::min(end[i], last_j + 1) - std::max(begin[i], first_j));
+    }
+    back_pointers->resize(offsets->back());
+    if (includes_skip_transition_) {
+      back_pointers_for_skip_transition->resize(offsets->back());
+    }
+  }
+
+  for (int i(begin_i); i < end_i; ++i) {
+    double* curr_scores(&((*scores)[i % num_rolling_rows_][0]));
+    double* curr_scores_for_skip_transition(
+        includes_skip_transition_
+            ? &((*scores_for_skip_transition)[i % num_rolling_rows_][0])
+            : NULL);
+
+    const int row_begin(std::max(begin[i], first_j));
+    const int row_end(std::min(end[i], last_j + 1));
+    for (int j(row_begin); j < row_end; ++j) {
       double local_distance;
       if (!distance_calculator_.Run(query_vector_sequence[i],
                                     reference_vector_sequence[j],
@@ -161,86 +333,343 @@ bool DynamicTimeWarping::Run(
         return false;
       }
 
-      double best_score_of_all_paths((0 == i && 0 == j) ? local_distance
-                                                        : DBL_MAX);
-      int best_i_of_all_paths(-1), best_j_of_all_paths(-1);
+      const bool is_first_cell(first_i == i && first_j == j);
+      double best_score_of_all_paths(is_first_cell ? local_distance : DBL_MAX);
+      int best_k_of_all_paths(-1);
 
-      double best_score_of_diagonal_paths(DBL_MAX);
-      int best_i_of_diagonal_paths(-1), best_j_of_diagonal_paths(-1);
+      double best_score_of_diagonal_paths(
+          (is_first_cell && is_first_entered_diagonally) ? local_distance
+                                                         : DBL_MAX);
+      int best_k_of_diagonal_paths(-1);
 
       for (int k(0); k < num_candidate; ++k) {
         const int i_k(i - local_path_candidates_[k].first);
         const int j_k(j - local_path_candidates_[k].second);
-        if (0 <= i_k && 0 <= j_k) {
+        if (first_i <= i_k && std::max(begin[i_k], first_j) <= j_k &&
+            j_k < end[i_k]) {
           double score;
-          if (includes_skip_transition && (i_k == i || j_k == j)) {
+          if (includes_skip_transition_ && (i_k == i || j_k == j)) {
             score = local_path_weights_[k] * local_distance +
-                    cell_for_skip_transition[i_k][j_k].score;
+                    (*scores_for_skip_transition)[i_k % num_rolling_rows_]
+                                                 [j_k - first_j];
           } else {
-            score =
-                local_path_weights_[k] * local_distance + cell[i_k][j_k].score;
+            score = local_path_weights_[k] * local_distance +
+                    (*scores)[i_k % num_rolling_rows_][j_k - first_j];
           }
 
-          if (includes_skip_transition && (i_k != i && j_k != j) &&
+          if (includes_skip_transition_ && (i_k != i && j_k != j) &&
               score < best_score_of_diagonal_paths) {
             best_score_of_diagonal_paths = score;
-            best_i_of_diagonal_paths = i_k;
-            best_j_of_diagonal_paths = j_k;
+            best_k_of_diagonal_paths = k;
+          }
+          if (score < best_score_of_all_paths) {
+            best_score_of_all_paths = score;
+            best_k_of_all_paths = k;
           }
+        }
+      }
+
+      if (includes_skip_transition_) {
+        curr_scores_for_skip_transition[j - first_j] =
+            best_score_of_diagonal_paths;
+      }
+      curr_scores[j - first_j] = best_score_of_all_paths;
+
+      if (stores_back_pointers) {
+        const std::size_t index((*offsets)[i - first_i] + (j - row_begin));
+        if (includes_skip_transition_) {
+          (*back_pointers_for_skip_transition)[index] =
+              static_cast<signed char>(best_k_of_diagonal_paths);
+        }
+        (*back_pointers)[index] = static_cast<signed char>(best_k_of_all_paths);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool DynamicTimeWarping::CalculateBackwardScores(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    const std::vector<int>& begin, const std::vector<int>& end, int first_j,
+    const std::pair<int, int>& last_cell, bool is_last_entered_diagonally,
+    int begin_i, std::vector<std::vector<double> >* scores,
+    std::vector<std::vector<double> >* scores_after_skip_transition,
+    std::vector<std::vector<double> >* local_distances) const {
+  const int num_candidate(local_path_candidates_.size());
+  const int last_i(last_cell.first);
+  const int last_j(last_cell.second);
+  const int width(last_j - first_j + 1);
+
+  scores->assign(num_rolling_rows_, std::vector<double>(width));
+  scores_after_skip_transition->assign(
+      includes_skip_transition_ ? num_rolling_rows_ : 0,
+      std::vector<double>(width));
+  local_distances->assign(num_rolling_rows_, std::vector<double>(width));
+
+  for (int i(last_i); begin_i <= i; --i) {
+    double* curr_scores(&((*scores)[i % num_rolling_rows_][0]));
+    double* curr_scores_after_skip_transition(
+        includes_skip_transition_
+            ? &((*scores_after_skip_transition)[i % num_rolling_rows_][0])
+            : NULL);
+    double* curr_local_distances(
+        &((*local_distances)[i % num_rolling_rows_][0]));
+
+    const int row_begin(std::max(begin[i], first_j));
+    const int row_end(std::min(end[i], last_j + 1));
+    for (int j(row_end - 1); row_begin <= j; --j) {
+      if (!distance_calculator_.Run(query_vector_sequence[i],
+                                    reference_vector_sequence[j],
+                                    &(curr_local_distances[j - first_j]))) {
+        return false;
+      }
+
+      const bool is_last_cell(last_i == i && last_j == j);
+      double best_score_of_all_paths(is_last_cell ? 0.0 : DBL_MAX);
+      double best_score_of_diagonal_paths(
+          (is_last_cell && !is_last_entered_diagonally) ? 0.0 : DBL_MAX);
+
+      for (int k(0); k < num_candidate; ++k) {
+        const int i_k(i + local_path_candidates_[k].first);
+        const int j_k(j + local_path_candidates_[k].second);
+        if (i_k <= last_i && j_k <= last_j && begin[i_k] <= j_k &&
+            j_k < end[i_k]) {
+          const int r_k(i_k % num_rolling_rows_);
+          const bool is_diagonal(i_k != i && j_k != j);
+          const double score(
+              local_path_weights_[k] *
+                  (*local_distances)[r_k][j_k - first_j] +
+              ((includes_skip_transition_ && !is_diagonal)
+                   ? (*scores_after_skip_transition)[r_k][j_k - first_j]
+                   : (*scores)[r_k][j_k - first_j]));
+
           if (score < best_score_of_all_paths) {
             best_score_of_all_paths = score;
-            best_i_of_all_paths = i_k;
-            best_j_of_all_paths = j_k;
+          }
+          if (is_diagonal && score < best_score_of_diagonal_paths) {
+            best_score_of_diagonal_paths = score;
           }
         }
       }
 
-      if (includes_skip_transition) {
-        cell_for_skip_transition[i][j].score = best_score_of_diagonal_paths;
-        cell_for_skip_transition[i][j].horizontal_back_pointer =
-            best_i_of_diagonal_paths;
-        cell_for_skip_transition[i][j].vertical_back_pointer =
-            best_j_of_diagonal_paths;
+      // A cell entered by a skip transition must be left diagonally.
+      if (includes_skip_transition_) {
+        curr_scores_after_skip_transition[j - first_j] =
+            best_score_of_diagonal_paths;
       }
-      cell[i][j].score = best_score_of_all_paths;
-      cell[i][j].horizontal_back_pointer = best_i_of_all_paths;
-      cell[i][j].vertical_back_pointer = best_j_of_all_paths;
+      curr_scores[j - first_j] = best_score_of_all_paths;
     }
   }
 
-  if (DBL_MAX == cell[num_query_vector - 1][num_reference_vector - 1].score) {
+  return true;
+}
+
+bool DynamicTimeWarping::FindViterbiPath(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    const std::vector<int>& begin, const std::vector<int>& end,
+    const std::pair<int, int>& first_cell, const std::pair<int, int>& last_cell,
+    bool is_first_entered_diagonally, bool is_last_entered_diagonally,
+    std::vector<std::pair<int, int> >* viterbi_path,
+    double* total_score) const {
+  const int first_i(first_cell.first);
+  const int first_j(first_cell.second);
+  const int last_i(last_cell.first);
+  const int last_j(last_cell.second);
+
+  const bool stores_back_pointers(NULL != viterbi_path);
+  std::vector<std::vector<double> > scores;
+  std::vector<std::vector<double> > scores_for_skip_transition;
+  std::vector<std::size_t> offsets;
+  std::vector<signed char> back_pointers;
+  std::vector<signed char> back_pointers_for_skip_transition;
+  if (!CalculateForwardScores(
+          query_vector_sequence, reference_vector_sequence, begin, end,
+          first_cell, last_j, is_first_entered_diagonally, first_i,
+          last_i + 1, &scores, &scores_for_skip_transition,
+          stores_back_pointers ? &offsets : NULL,
+          stores_back_pointers ? &back_pointers : NULL,
+          stores_back_pointers ? &back_pointers_for_skip_transition : NULL)) {
     return false;
   }
 
-  *total_score = cell[num_query_vector - 1][num_reference_vector - 1].score /
-                 (num_query_vector + num_reference_vector);
+  const bool skip_transition_at_last(includes_skip_transition_ &&
+                                     is_last_entered_diagonally);
+  if (last_j < begin[last_i] || end[last_i] <= last_j) {
+    return false;
+  }
+  const double score(
+      skip_transition_at_last
+          ? scores_for_skip_transition[last_i % num_rolling_rows_]
+                                      [last_j - first_j]
+          : scores[last_i % num_rolling_rows_][last_j - first_j]);
+  if (DBL_MAX <= score) {
+    return false;
+  }
+  if (NULL != total_score) {
+    *total_score = score;
+  }
 
-  {
-    bool skip_transition(false);
-    int i(num_query_vector - 1);
-    int j(num_reference_vector - 1);
-    viterbi_path->clear();
-    viterbi_path->push_back(std::make_pair(i, j));
-    while (0 <= i && 0 <= j) {
-      const int prev_i(
-          (includes_skip_transition && skip_transition)
-              ? cell_for_skip_transition[i][j].horizontal_back_pointer
-              : cell[i][j].horizontal_back_pointer);
-      const int prev_j(
-          (includes_skip_transition && skip_transition)
-              ? cell_for_skip_transition[i][j].vertical_back_pointer
-              : cell[i][j].vertical_back_pointer);
-      if (0 <= prev_i && 0 <= prev_j) {
-        viterbi_path->push_back(std::make_pair(prev_i, prev_j));
-      }
-      skip_transition = (prev_i == i || prev_j == j) ? true : false;
+  if (stores_back_pointers) {
+    std::vector<std::pair<int, int> > path;
+    bool skip_transition(skip_transition_at_last);
+    int i(last_i);
+    int j(last_j);
+    path.push_back(std::make_pair(i, j));
+    for (;;) {
+      const std::size_t index(offsets[i - first_i] +
+                              (j - std::max(begin[i], first_j)));
+      const int k((includes_skip_transition_ && skip_transition)
+                      ? back_pointers_for_skip_transition[index]
+                      : back_pointers[index]);
+      if (k < 0) break;
+      const int prev_i(i - local_path_candidates_[k].first);
+      const int prev_j(j - local_path_candidates_[k].second);
+      path.push_back(std::make_pair(prev_i, prev_j));
+      skip_transition = (prev_i == i || prev_j == j);
       i = prev_i;
       j = prev_j;
     }
-    std::reverse(viterbi_path->begin(), viterbi_path->end());
+    viterbi_path->insert(viterbi_path->end(), path.rbegin(), path.rend());
   }
 
   return true;
 }
 
+bool DynamicTimeWarping::FindViterbiPathByDivideAndConquer(
+    const std::vector<std::vector<double> >& query_vector_sequence,
+    const std::vector<std::vector<double> >& reference_vector_sequence,
+    const std::vector<int>& begin, const std::vector<int>& end,
+    const std::pair<int, int>& first_cell, const std::pair<int, int>& last_cell,
+    bool is_first_entered_diagonally, bool is_last_entered_diagonally,
+    std::vector<std::pair<int, int> >* viterbi_path,
+    double* total_score) const {
+  const int first_i(first_cell.first);
+  const int first_j(first_cell.second);
+  const int last_i(last_cell.first);
+  const int last_j(last_cell.second);
+
+  // Use back pointers if they fit in the memory.
+  std::size_t num_cell(0);
+  for (int i(first_i); i <= last_i; ++i) {
+    num_cell += std::max(
+        0, std::min(end[i], last_j + 1) - std::max(begin[i], first_j));
+  }
+  if (first_i == last_i ||
+      num_cell * (includes_skip_transition_ ? 2 : 1) <= maximum_memory_size_) {
+    return FindViterbiPath(query_vector_sequence, reference_vector_sequence,
+                           begin, end, first_cell, last_cell,
+                           is_first_entered_diagonally,
+                           is_last_entered_diagonally, viterbi_path,
+                           total_score);
+  }
+
+  // Find the transition over the middle row on the best path, that is, the
+  // one minimizing the sum of the forward score, the weighted local distance,
+  // and the backward score.
+  const int middle_i((first_i + last_i) / 2);
+  std::pair<int, int> best_prev_cell;
+  std::pair<int, int> best_next_cell;
+  bool is_best_transition_diagonal(false);
+  {
+    std::vector<std::vector<double> > forward_scores;
+    std::vector<std::vector<double> > forward_scores_for_skip_transition;
+    if (!CalculateForwardScores(
+            query_vector_sequence, reference_vector_sequence, begin, end,
+            first_cell, last_j, is_first_entered_diagonally, first_i,
+            middle_i + 1, &forward_scores, &forward_scores_for_skip_transition,
+            NULL, NULL, NULL)) {
+      return false;
+    }
+
+    if (NULL != total_score) {
+      std::vector<std::vector<double> > scores(forward_scores);
+      std::vector<std::vector<double> > scores_for_skip_transition(
+          forward_scores_for_skip_transition);
+      if (!CalculateForwardScores(
+              query_vector_sequence, reference_vector_sequence, begin, end,
+              first_cell, last_j, is_first_entered_diagonally, middle_i + 1,
+              last_i + 1, &scores, &scores_for_skip_transition, NULL, NULL,
+              NULL)) {
+        return false;
+      }
+      if (last_j < begin[last_i] || end[last_i] <= last_j) {
+        return false;
+      }
+      *total_score =
+          (includes_skip_transition_ && is_last_entered_diagonally)
+              ? scores_for_skip_transition[last_i % num_rolling_rows_]
+                                          [last_j - first_j]
+              : scores[last_i % num_rolling_rows_][last_j - first_j];
+      if (DBL_MAX <= *total_score) {
+        return false;
+      }
+    }
+
+    std::vector<std::vector<double> > backward_scores;
+    std::vector<std::vector<double> > backward_scores_after_skip_transition;
+    std::vector<std::vector<double> > local_distances;
+    if (!CalculateBackwardScores(
+            query_vector_sequence, reference_vector_sequence, begin, end,
+            first_j, last_cell, is_last_entered_diagonally, middle_i + 1,
+            &backward_scores, &backward_scores_after_skip_transition,
+            &local_distances)) {
+      return false;
+    }
+
+    const int num_candidate(local_path_candidates_.size());
+    double best_score(DBL_MAX);
+    for (int i(std::max(first_i, middle_i - num_rolling_rows_ + 2));
+         i <= middle_i; ++i) {
+      const int r(i % num_rolling_rows_);
+      const int row_begin(std::max(begin[i], first_j));
+      const int row_end(std::min(end[i], last_j + 1));
+      for (int j(row_begin); j < row_end; ++j) {
+        for (int k(0); k < num_candidate; ++k) {
+          const int i_k(i + local_path_candidates_[k].first);
+          const int j_k(j + local_path_candidates_[k].second);
+          if (middle_i < i_k && i_k <= last_i && j_k <= last_j &&
+              begin[i_k] <= j_k && j_k < end[i_k]) {
+            const int r_k(i_k % num_rolling_rows_);
+            const bool is_diagonal(j_k != j);
+            const bool is_skip_transition(includes_skip_transition_ &&
+                                          !is_diagonal);
+            const double score(
+                (is_skip_transition
+                     ? forward_scores_for_skip_transition[r][j - first_j]
+                     : forward_scores[r][j - first_j]) +
+                local_path_weights_[k] * local_distances[r_k][j_k - first_j] +
+                (is_skip_transition
+                     ? backward_scores_after_skip_transition[r_k]
+                                                            [j_k - first_j]
+                     : backward_scores[r_k][j_k - first_j]));
+            if (score < best_score) {
+              best_score = score;
+              best_prev_cell = std::make_pair(i, j);
+              best_next_cell = std::make_pair(i_k, j_k);
+              is_best_transition_diagonal = is_diagonal;
+            }
+          }
+        }
+      }
+    }
+    if (DBL_MAX <= best_score) {
+      return false;
+    }
+  }
+
+  // If the transition is a skip one, the previous cell must be entered
+  // diagonally.
+  return (FindViterbiPathByDivideAndConquer(
+              query_vector_sequence, reference_vector_sequence, begin, end,
+              first_cell, best_prev_cell, is_first_entered_diagonally,
+              !is_best_transition_diagonal, viterbi_path, NULL) &&
+          FindViterbiPathByDivideAndConquer(
+              query_vector_sequence, reference_vector_sequence, begin, end,
+              best_next_cell, last_cell, is_best_transition_diagonal,
+              is_last_entered_diagonally, viterbi_path, NULL));
+}
+
 }  // namespace sptk
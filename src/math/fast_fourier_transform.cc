@@ -44,30 +44,373 @@
 
 #include "SPTK/math/fast_fourier_transform.h"
 
-#include <algorithm>  // std::copy, std::fill
-#include <cmath>      // std::sin
+#include <algorithm>  // std::copy, std::fill, std::max, std::swap
+#include <cmath>      // std::cos, std::sin
 #include <cstddef>    // std::size_t
+#include <cstdint>    // int64_t
+
+namespace {
+
+// Prime factors larger than this value are not handled by the generic
+// butterfly of the mixed-radix algorithm, since its cost grows linearly with
+// the factor. Bluestein's algorithm is used instead.
+const int kMaximumRadix(31);
+
+// Decompose the given length into radices used by the mixed-radix algorithm.
+// The radix 4 is preferred over the radix 2 as it requires fewer stages.
+bool Factorize(int length, std::vector<int>* radices) {
+  radices->clear();
+  while (0 == length % 4) {
+    radices->push_back(4);
+    length /= 4;
+  }
+  const int special_radices[] = {2, 3, 5};
+  for (int radix : special_radices) {
+    while (0 == length % radix) {
+      radices->push_back(radix);
+      length /= radix;
+    }
+  }
+  for (int radix(7); radix <= kMaximumRadix && 1 < length; radix += 2) {
+    while (0 == length % radix) {
+      radices->push_back(radix);
+      length /= radix;
+    }
+  }
+  return 1 == length;
+}
+
+// The butterflies below process one stage of sub-length L = radix * m.
+// The twiddle factors W_L^(jk), j = 0, ..., m-1, are stored contiguously
+// for each k = 1, ..., radix-1 so that the innermost loop over j has unit
+// stride in every array it touches and can be vectorized by the compiler.
+
+void RunRadixTwoStage(int fft_length, int m, const double* c, const double* s,
+                      double* x, double* y) {
+  for (int offset(0); offset < fft_length; offset += 2 * m) {
+    double* x0(x + offset);
+    double* y0(y + offset);
+    double* x1(x0 + m);
+    double* y1(y0 + m);
+    for (int j(0); j < m; ++j) {
+      const double t1(x0[j] - x1[j]);
+      const double t2(y0[j] - y1[j]);
+      x0[j] += x1[j];
+      y0[j] += y1[j];
+      x1[j] = c[j] * t1 + s[j] * t2;
+      y1[j] = c[j] * t2 - s[j] * t1;
+    }
+  }
+}
+
+void RunRadixThreeStage(int fft_length, int m, const double* c,
+                        const double* s, double* x, double* y) {
+  const double half_sqrt3(0.8660254037844386);
+  const double* c1(c);
+  const double* s1(s);
+  const double* c2(c + m);
+  const double* s2(s + m);
+  for (int offset(0); offset < fft_length; offset += 3 * m) {
+    double* x0(x + offset);
+    double* y0(y + offset);
+    double* x1(x0 + m);
+    double* y1(y0 + m);
+    double* x2(x1 + m);
+    double* y2(y1 + m);
+    for (int j(0); j < m; ++j) {
+      const double sum_x(x1[j] + x2[j]);
+      const double sum_y(y1[j] + y2[j]);
+      const double diff_x(half_sqrt3 * (x1[j] - x2[j]));
+      const double diff_y(half_sqrt3 * (y1[j] - y2[j]));
+      const double base_x(x0[j] - 0.5 * sum_x);
+      const double base_y(y0[j] - 0.5 * sum_y);
+      x0[j] += sum_x;
+      y0[j] += sum_y;
+
+      const double u1(base_x + diff_y);
+      const double v1(base_y - diff_x);
+      const double u2(base_x - diff_y);
+      const double v2(base_y + diff_x);
+      x1[j] = c1[j] * u1 + s1[j] * v1;
+      y1[j] = c1[j] * v1 - s1[j] * u1;
+      x2[j] = c2[j] * u2 + s2[j] * v2;
+      y2[j] = c2[j] * v2 - s2[j] * u2;
+    }
+  }
+}
+
+void RunRadixFourStage(int fft_length, int m, const double* c, const double* s,
+                       double* x, double* y) {
+  const double* c1(c);
+  const double* s1(s);
+  const double* c2(c + m);
+  const double* s2(s + m);
+  const double* c3(c + 2 * m);
+  const double* s3(s + 2 * m);
+  for (int offset(0); offset < fft_length; offset += 4 * m) {
+    double* x0(x + offset);
+    double* y0(y + offset);
+    double* x1(x0 + m);
+    double* y1(y0 + m);
+    double* x2(x1 + m);
+    double* y2(y1 + m);
+    double* x3(x2 + m);
+    double* y3(y2 + m);
+    for (int j(0); j < m; ++j) {
+      const double a0_x(x0[j] + x2[j]);
+      const double a0_y(y0[j] + y2[j]);
+      const double a1_x(x0[j] - x2[j]);
+      const double a1_y(y0[j] - y2[j]);
+      const double a2_x(x1[j] + x3[j]);
+      const double a2_y(y1[j] + y3[j]);
+      const double a3_x(x1[j] - x3[j]);
+      const double a3_y(y1[j] - y3[j]);
+      x0[j] = a0_x + a2_x;
+      y0[j] = a0_y + a2_y;
+
+      const double u1(a1_x + a3_y);
+      const double v1(a1_y - a3_x);
+      const double u2(a0_x - a2_x);
+      const double v2(a0_y - a2_y);
+      const double u3(a1_x - a3_y);
+      const double v3(a1_y + a3_x);
+      x1[j] = c1[j] * u1 + s1[j] * v1;
+      y1[j] = c1[j] * v1 - s1[j] * u1;
+      x2[j] = c2[j] * u2 + s2[j] * v2;
+      y2[j] = c2[j] * v2 - s2[j] * u2;
+      x3[j] = c3[j] * u3 + s3[j] * v3;
+      y3[j] = c3[j] * v3 - s3[j] * u3;
+    }
+  }
+}
+
+void RunRadixFiveStage(int fft_length, int m, const double* c, const double* s,
+                       double* x, double* y) {
+  const double cos1(0.30901699437494745);  // cos(2pi/5)
+  const double cos2(-0.8090169943749475);  // cos(4pi/5)
+  const double sin1(0.9510565162951535);   // sin(2pi/5)
+  const double sin2(0.5877852522924731);   // sin(4pi/5)
+  const double* c1(c);
+  const double* s1(s);
+  const double* c2(c + m);
+  const double* s2(s + m);
+  const double* c3(c + 2 * m);
+  const double* s3(s + 2 * m);
+  const double* c4(c + 3 * m);
+  const double* s4(s + 3 * m);
+  for (int offset(0); offset < fft_length; offset += 5 * m) {
+    double* x0(x + offset);
+    double* y0(y + offset);
+    double* x1(x0 + m);
+    double* y1(y0 + m);
+    double* x2(x1 + m);
+    double* y2(y1 + m);
+    double* x3(x2 + m);
+    double* y3(y2 + m);
+    double* x4(x3 + m);
+    double* y4(y3 + m);
+    for (int j(0); j < m; ++j) {
+      const double a1_x(x1[j] + x4[j]);
+      const double a1_y(y1[j] + y4[j]);
+      const double b1_x(x1[j] - x4[j]);
+      const double b1_y(y1[j] - y4[j]);
+      const double a2_x(x2[j] + x3[j]);
+      const double a2_y(y2[j] + y3[j]);
+      const double b2_x(x2[j] - x3[j]);
+      const double b2_y(y2[j] - y3[j]);
+
+      const double p1_x(x0[j] + cos1 * a1_x + cos2 * a2_x);
+      const double p1_y(y0[j] + cos1 * a1_y + cos2 * a2_y);
+      const double p2_x(x0[j] + cos2 * a1_x + cos1 * a2_x);
+      const double p2_y(y0[j] + cos2 * a1_y + cos1 * a2_y);
+      const double q1_x(sin1 * b1_x + sin2 * b2_x);
+      const double q1_y(sin1 * b1_y + sin2 * b2_y);
+      const double q2_x(sin2 * b1_x - sin1 * b2_x);
+      const double q2_y(sin2 * b1_y - sin1 * b2_y);
+      x0[j] += a1_x + a2_x;
+      y0[j] += a1_y + a2_y;
+
+      const double u1(p1_x + q1_y);
+      const double v1(p1_y - q1_x);
+      const double u2(p2_x + q2_y);
+      const double v2(p2_y - q2_x);
+      const double u3(p2_x - q2_y);
+      const double v3(p2_y + q2_x);
+      const double u4(p1_x - q1_y);
+      const double v4(p1_y + q1_x);
+      x1[j] = c1[j] * u1 + s1[j] * v1;
+      y1[j] = c1[j] * v1 - s1[j] * u1;
+      x2[j] = c2[j] * u2 + s2[j] * v2;
+      y2[j] = c2[j] * v2 - s2[j] * u2;
+      x3[j] = c3[j] * u3 + s3[j] * v3;
+      y3[j] = c3[j] * v3 - s3[j] * u3;
+      x4[j] = c4[j] * u4 + s4[j] * v4;
+      y4[j] = c4[j] * v4 - s4[j] * u4;
+    }
+  }
+}
+
+// Generic butterfly computed by the direct DFT of length radix. The arrays
+// c0 and s0 hold W_radix^k and buffer holds 2 * radix elements.
+void RunGenericRadixStage(int fft_length, int radix, int m, const double* c,
+                          const double* s, const double* c0, const double* s0,
+                          double* buffer, double* x, double* y) {
+  double* buffer_x(buffer);
+  double* buffer_y(buffer + radix);
+  for (int offset(0); offset < fft_length; offset += radix * m) {
+    for (int j(0); j < m; ++j) {
+      double* xp(x + offset + j);
+      double* yp(y + offset + j);
+      for (int r(0); r < radix; ++r) {
+        buffer_x[r] = xp[r * m];
+        buffer_y[r] = yp[r * m];
+      }
+      for (int k(0); k < radix; ++k) {
+        double sum_x(buffer_x[0]);
+        double sum_y(buffer_y[0]);
+        for (int r(1), rk(k); r < radix; ++r, rk += k) {
+          if (radix <= rk) rk -= radix;
+          sum_x += c0[rk] * buffer_x[r] + s0[rk] * buffer_y[r];
+          sum_y += c0[rk] * buffer_y[r] - s0[rk] * buffer_x[r];
+        }
+        if (0 == k) {
+          xp[0] = sum_x;
+          yp[0] = sum_y;
+        } else {
+          const int index((k - 1) * m + j);
+          xp[k * m] = c[index] * sum_x + s[index] * sum_y;
+          yp[k * m] = c[index] * sum_y - s[index] * sum_x;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
 
 namespace sptk {
 
 FastFourierTransform::FastFourierTransform(int num_order, int fft_length)
     : num_order_(num_order),
       fft_length_(fft_length),
-      half_fft_length_(fft_length_ / 2),
-      is_valid_(true) {
-  if (num_order_ < 0 || fft_length_ <= num_order_ ||
-      !IsPowerOfTwo(fft_length_)) {
+      algorithm_(kMixedRadix),
+      is_valid_(true),
+      max_radix_(0),
+      bluestein_fast_fourier_transform_(NULL) {
+  if (num_order_ < 0 || fft_length_ <= num_order_) {
     is_valid_ = false;
     return;
   }
 
-  const int table_size(fft_length_ - fft_length_ / 4 + 1);
-  const double argument(sptk::kPi / fft_length_ * 2);
-  sine_table_.resize(table_size);
-  for (int i(0); i < table_size; ++i) {
-    sine_table_[i] = std::sin(argument * i);
+  if (Factorize(fft_length_, &radices_)) {
+    algorithm_ = kMixedRadix;
+
+    const int num_stages(radices_.size());
+    const double argument(sptk::kPi / fft_length_ * 2);
+
+    // twiddle factors of each stage, W_L^(jk) = W_N^(jkN/L)
+    stage_cosine_tables_.resize(num_stages);
+    stage_sine_tables_.resize(num_stages);
+    for (int i(0), sub_length(fft_length_), stride(1); i < num_stages; ++i) {
+      const int radix(radices_[i]);
+      const int m(sub_length / radix);
+      stage_cosine_tables_[i].resize((radix - 1) * m);
+      stage_sine_tables_[i].resize((radix - 1) * m);
+      for (int k(1); k < radix; ++k) {
+        for (int j(0); j < m; ++j) {
+          // jkN/L never exceeds N-1
+          const int index(j * k * stride);
+          stage_cosine_tables_[i][(k - 1) * m + j] = std::cos(argument * index);
+          stage_sine_tables_[i][(k - 1) * m + j] = std::sin(argument * index);
+        }
+      }
+      max_radix_ = std::max(max_radix_, radix);
+      sub_length = m;
+      stride *= radix;
+    }
+
+    // roots of unity W_radix^k used by the generic butterfly
+    radix_cosine_tables_.resize(num_stages);
+    radix_sine_tables_.resize(num_stages);
+    for (int i(0); i < num_stages; ++i) {
+      const int radix(radices_[i]);
+      if (radix <= 5) continue;
+      radix_cosine_tables_[i].resize(radix);
+      radix_sine_tables_[i].resize(radix);
+      for (int k(0); k < radix; ++k) {
+        radix_cosine_tables_[i][k] = std::cos(sptk::kPi * 2 * k / radix);
+        radix_sine_tables_[i][k] = std::sin(sptk::kPi * 2 * k / radix);
+      }
+    }
+
+    // The decimation-in-frequency stages leave the k-th frequency component
+    // at the digit-reversed position of k. Precompute a sequence of swaps
+    // which puts the components back in order in place.
+    std::vector<int> position_to_index(fft_length_);
+    std::vector<int> index_to_position(fft_length_);
+    for (int i(0); i < fft_length_; ++i) {
+      position_to_index[i] = i;
+      index_to_position[i] = i;
+    }
+    for (int k(0); k < fft_length_; ++k) {
+      int digit_reversed_k(0);
+      for (int i(0), rest(k), sub_length(fft_length_); i < num_stages; ++i) {
+        sub_length /= radices_[i];
+        digit_reversed_k += (rest % radices_[i]) * sub_length;
+        rest /= radices_[i];
+      }
+      const int j(index_to_position[digit_reversed_k]);
+      if (j != k) {
+        digit_reversal_swap_table_.push_back(k);
+        digit_reversal_swap_table_.push_back(j);
+        const int displaced_index(position_to_index[k]);
+        position_to_index[k] = digit_reversed_k;
+        position_to_index[j] = displaced_index;
+        index_to_position[digit_reversed_k] = k;
+        index_to_position[displaced_index] = j;
+      }
+    }
+  } else {
+    algorithm_ = kBluestein;
+
+    // Bluestein's algorithm rewrites the DFT of length N as a circular
+    // convolution with a chirp, which is computed by a radix-2 FFT of length
+    // greater than or equal to 2N-1.
+    int convolution_length(1);
+    while (convolution_length < 2 * fft_length_ - 1) {
+      convolution_length *= 2;
+    }
+    bluestein_fast_fourier_transform_ =
+        new FastFourierTransform(convolution_length - 1, convolution_length);
+
+    chirp_real_part_.resize(fft_length_);
+    chirp_imaginary_part_.resize(fft_length_);
+    for (int i(0); i < fft_length_; ++i) {
+      // Reduce i^2 modulo 2N beforehand to keep the argument accurate.
+      const int64_t squared_i(static_cast<int64_t>(i) * i %
+                              (2 * fft_length_));
+      const double argument(sptk::kPi * squared_i / fft_length_);
+      chirp_real_part_[i] = std::cos(argument);
+      chirp_imaginary_part_[i] = -std::sin(argument);
+    }
+
+    std::vector<double> filter_real_part(convolution_length, 0.0);
+    std::vector<double> filter_imaginary_part(convolution_length, 0.0);
+    filter_real_part[0] = chirp_real_part_[0];
+    filter_imaginary_part[0] = -chirp_imaginary_part_[0];
+    for (int i(1); i < fft_length_; ++i) {
+      filter_real_part[i] = chirp_real_part_[i];
+      filter_imaginary_part[i] = -chirp_imaginary_part_[i];
+      filter_real_part[convolution_length - i] = chirp_real_part_[i];
+      filter_imaginary_part[convolution_length - i] = -chirp_imaginary_part_[i];
+    }
+    if (!bluestein_fast_fourier_transform_->Run(
+            filter_real_part, filter_imaginary_part, &chirp_filter_real_part_,
+            &chirp_filter_imaginary_part_)) {
+      is_valid_ = false;
+      return;
+    }
   }
-  sine_table_[fft_length_ / 2] = 0.0;
 }
 
 bool FastFourierTransform::Run(
@@ -104,78 +447,199 @@ bool FastFourierTransform::Run(
   double* x(&((*real_part_output)[0]));
   double* y(&((*imaginary_part_output)[0]));
 
-  {
-    int lix(fft_length_);
-    int lmx(half_fft_length_);
-    int lf(1);
-    while (1 < lmx) {
-      double* sinp(const_cast<double*>(&(sine_table_[0])));
-      double* cosp(const_cast<double*>(&(sine_table_[0])) + fft_length_ / 4);
-      for (int i(0); i < lmx; ++i) {
-        double* xpi(&(x[i]));
-        double* ypi(&(y[i]));
-        for (int li(lix); li <= fft_length_; li += lix) {
-          const double t1(*(xpi) - *(xpi + lmx));
-          const double t2(*(ypi) - *(ypi + lmx));
-          *(xpi) += *(xpi + lmx);
-          *(ypi) += *(ypi + lmx);
-          *(xpi + lmx) = *cosp * t1 + *sinp * t2;
-          *(ypi + lmx) = *cosp * t2 - *sinp * t1;
-          xpi += lix;
-          ypi += lix;
-        }
-        sinp += lf;
-        cosp += lf;
+  switch (algorithm_) {
+    case kMixedRadix: {
+      RunMixedRadix(1, x, y);
+      break;
+    }
+    case kBluestein: {
+      RunBluestein(1, x, y);
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool FastFourierTransform::Run(const sptk::Matrix& real_part_input,
+                               const sptk::Matrix& imaginary_part_input,
+                               sptk::Matrix* real_part_output,
+                               sptk::Matrix* imaginary_part_output) const {
+  // check inputs
+  const int num_frames(real_part_input.GetNumRow());
+  if (!is_valid_ || num_frames <= 0 ||
+      real_part_input.GetNumColumn() != num_order_ + 1 ||
+      imaginary_part_input.GetNumRow() != num_frames ||
+      imaginary_part_input.GetNumColumn() != num_order_ + 1 ||
+      NULL == real_part_output || NULL == imaginary_part_output) {
+    return false;
+  }
+
+  // prepare memories
+  if (real_part_output->GetNumRow() != num_frames ||
+      real_part_output->GetNumColumn() != fft_length_) {
+    real_part_output->Resize(num_frames, fft_length_);
+  }
+  if (imaginary_part_output->GetNumRow() != num_frames ||
+      imaginary_part_output->GetNumColumn() != fft_length_) {
+    imaginary_part_output->Resize(num_frames, fft_length_);
+  }
+
+  // get values and fill zero
+  const int input_length(num_order_ + 1);
+  for (int i(0); i < num_frames; ++i) {
+    std::copy(real_part_input[i], real_part_input[i] + input_length,
+              (*real_part_output)[i]);
+    std::fill((*real_part_output)[i] + input_length,
+              (*real_part_output)[i] + fft_length_, 0.0);
+    std::copy(imaginary_part_input[i], imaginary_part_input[i] + input_length,
+              (*imaginary_part_output)[i]);
+    std::fill((*imaginary_part_output)[i] + input_length,
+              (*imaginary_part_output)[i] + fft_length_, 0.0);
+  }
+
+  // The rows of a matrix are contiguous in memory.
+  double* x((*real_part_output)[0]);
+  double* y((*imaginary_part_output)[0]);
+
+  switch (algorithm_) {
+    case kMixedRadix: {
+      RunMixedRadix(num_frames, x, y);
+      break;
+    }
+    case kBluestein: {
+      RunBluestein(num_frames, x, y);
+      break;
+    }
+    default: {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Decimation-in-frequency FFT whose length is factorized as a product of
+// small radices. Power-of-two lengths are handled by radix-4 stages followed
+// by at most one radix-2 stage. Since the sub-length of every stage divides
+// the FFT length, a stage sweeps over consecutive frames in a single pass.
+void FastFourierTransform::RunMixedRadix(int num_frames, double* x,
+                                         double* y) const {
+  std::vector<double> buffer;
+  if (5 < max_radix_) {
+    buffer.resize(2 * max_radix_);
+  }
+
+  const int total_length(num_frames * fft_length_);
+
+  const int num_stages(radices_.size());
+  for (int i(0), sub_length(fft_length_); i < num_stages; ++i) {
+    const int radix(radices_[i]);
+    const int m(sub_length / radix);
+    const double* c(&(stage_cosine_tables_[i][0]));
+    const double* s(&(stage_sine_tables_[i][0]));
+
+    switch (radix) {
+      case 2: {
+        RunRadixTwoStage(total_length, m, c, s, x, y);
+        break;
       }
-      lix = lmx;
-      lmx /= 2;
-      lf *= 2;
-    }
-  }
-
-  {
-    double* xp(x);
-    double* yp(y);
-    for (int li(0); li < half_fft_length_; ++li) {
-      const double t1(*(xp) - *(xp + 1));
-      const double t2(*(yp) - *(yp + 1));
-      *(xp) += *(xp + 1);
-      *(yp) += *(yp + 1);
-      *(xp + 1) = t1;
-      *(yp + 1) = t2;
-      xp += 2;
-      yp += 2;
-    }
-  }
-
-  // bit reversal
-  {
-    double* xp(x);
-    double* yp(y);
-    const int dec_fft_length(fft_length_ - 1);
-    for (int lmx(0), j(0); lmx < dec_fft_length; ++lmx) {
-      const int lmxj(lmx - j);
-      if (lmxj < 0) {
-        const double t1(*(xp));
-        const double t2(*(yp));
-        *(xp) = *(xp + lmxj);
-        *(yp) = *(yp + lmxj);
-        *(xp + lmxj) = t1;
-        *(yp + lmxj) = t2;
+      case 3: {
+        RunRadixThreeStage(total_length, m, c, s, x, y);
+        break;
       }
-
-      int li(half_fft_length_);
-      while (li <= j) {
-        j -= li;
-        li /= 2;
+      case 4: {
+        RunRadixFourStage(total_length, m, c, s, x, y);
+        break;
+      }
+      case 5: {
+        RunRadixFiveStage(total_length, m, c, s, x, y);
+        break;
+      }
+      default: {
+        RunGenericRadixStage(total_length, radix, m, c, s,
+                             &(radix_cosine_tables_[i][0]),
+                             &(radix_sine_tables_[i][0]), &(buffer[0]), x, y);
+        break;
       }
-      j += li;
-      xp = x + j;
-      yp = y + j;
     }
+
+    sub_length = m;
   }
 
-  return true;
+  // digit reversal
+  const int num_swaps(digit_reversal_swap_table_.size() / 2);
+  const int* swap_table(num_swaps ? &(digit_reversal_swap_table_[0]) : NULL);
+  for (int offset(0); offset < total_length; offset += fft_length_) {
+    double* xp(x + offset);
+    double* yp(y + offset);
+    for (int i(0); i < num_swaps; ++i) {
+      const int j(swap_table[2 * i]);
+      const int k(swap_table[2 * i + 1]);
+      std::swap(xp[j], xp[k]);
+      std::swap(yp[j], yp[k]);
+    }
+  }
+}
+
+// Bluestein's algorithm. Using nk = (n^2 + k^2 - (k-n)^2) / 2,
+// X(k) = w(k) sum_n x(n) w(n) w*(k-n), where w(n) = exp(-j pi n^2 / N).
+// The convolution is performed via the precomputed spectrum of w*(n).
+void FastFourierTransform::RunBluestein(int num_frames, double* x,
+                                        double* y) const {
+  const int convolution_length(
+      bluestein_fast_fourier_transform_->GetFftLength());
+
+  sptk::Matrix real_part(num_frames, convolution_length);
+  sptk::Matrix imaginary_part(num_frames, convolution_length);
+  for (int f(0); f < num_frames; ++f) {
+    const double* xp(x + f * fft_length_);
+    const double* yp(y + f * fft_length_);
+    for (int i(0); i < fft_length_; ++i) {
+      real_part[f][i] =
+          xp[i] * chirp_real_part_[i] - yp[i] * chirp_imaginary_part_[i];
+      imaginary_part[f][i] =
+          xp[i] * chirp_imaginary_part_[i] + yp[i] * chirp_real_part_[i];
+    }
+  }
+
+  sptk::Matrix spectrum_real_part;
+  sptk::Matrix spectrum_imaginary_part;
+  bluestein_fast_fourier_transform_->Run(real_part, imaginary_part,
+                                         &spectrum_real_part,
+                                         &spectrum_imaginary_part);
+
+  // multiply by the filter and take the complex conjugate so that the forward
+  // transform can be reused as the inverse one
+  for (int f(0); f < num_frames; ++f) {
+    for (int i(0); i < convolution_length; ++i) {
+      const double a(spectrum_real_part[f][i]);
+      const double b(spectrum_imaginary_part[f][i]);
+      const double c(chirp_filter_real_part_[i]);
+      const double d(chirp_filter_imaginary_part_[i]);
+      real_part[f][i] = a * c - b * d;
+      imaginary_part[f][i] = -(a * d + b * c);
+    }
+  }
+  bluestein_fast_fourier_transform_->Run(real_part, imaginary_part,
+                                         &spectrum_real_part,
+                                         &spectrum_imaginary_part);
+
+  const double inverse_convolution_length(1.0 / convolution_length);
+  for (int f(0); f < num_frames; ++f) {
+    double* xp(x + f * fft_length_);
+    double* yp(y + f * fft_length_);
+    for (int i(0); i < fft_length_; ++i) {
+      const double a(spectrum_real_part[f][i] * inverse_convolution_length);
+      const double b(-spectrum_imaginary_part[f][i] *
+                     inverse_convolution_length);
+      xp[i] = a * chirp_real_part_[i] - b * chirp_imaginary_part_[i];
+      yp[i] = a * chirp_imaginary_part_[i] + b * chirp_real_part_[i];
+    }
+  }
 }
 
 }  // namespace sptk
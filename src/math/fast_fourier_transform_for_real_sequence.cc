@@ -44,32 +44,39 @@
 
 #include "SPTK/math/fast_fourier_transform_for_real_sequence.h"
 
-#include <algorithm>  // std::fill
-#include <cmath>      // std::sin
+#include <algorithm>  // std::copy, std::fill
+#include <cmath>      // std::cos, std::sin
 #include <cstddef>    // std::size_t
 
 namespace sptk {
 
 FastFourierTransformForRealSequence::FastFourierTransformForRealSequence(
     int num_order, int fft_length)
+    : FastFourierTransformForRealSequence(num_order, fft_length, false) {
+}
+
+FastFourierTransformForRealSequence::FastFourierTransformForRealSequence(
+    int num_order, int fft_length, bool half_length_output)
     : num_order_(num_order),
       fft_length_(fft_length),
       half_fft_length_(fft_length_ / 2),
+      half_length_output_(half_length_output),
+      output_length_(half_length_output_ ? half_fft_length_ + 1 : fft_length_),
       fast_fourier_transform_(half_fft_length_ - 1, half_fft_length_),
       is_valid_(true) {
-  if (num_order_ < 0 || fft_length_ <= num_order_ ||
-      !IsPowerOfTwo(fft_length_) || !fast_fourier_transform_.IsValid()) {
+  if (num_order_ < 0 || fft_length_ <= num_order_ || 0 != fft_length_ % 2 ||
+      !fast_fourier_transform_.IsValid()) {
     is_valid_ = false;
     return;
   }
 
-  const int table_size(fft_length_ - fft_length_ / 4 + 1);
   const double argument(sptk::kPi / fft_length_ * 2);
-  sine_table_.resize(table_size);
-  for (int i(0); i < table_size; ++i) {
+  sine_table_.resize(half_fft_length_);
+  cosine_table_.resize(half_fft_length_);
+  for (int i(0); i < half_fft_length_; ++i) {
     sine_table_[i] = std::sin(argument * i);
+    cosine_table_[i] = std::cos(argument * i);
   }
-  sine_table_[fft_length_ / 2] = 0.0;
 }
 
 bool FastFourierTransformForRealSequence::Run(
@@ -94,12 +101,13 @@ bool FastFourierTransformForRealSequence::Run(
       static_cast<std::size_t>(half_fft_length_)) {
     buffer->imaginary_part_input_.resize(half_fft_length_);
   }
-  if (real_part_output->capacity() < static_cast<std::size_t>(fft_length_)) {
-    real_part_output->reserve(fft_length_);
+  if (real_part_output->capacity() <
+      static_cast<std::size_t>(output_length_)) {
+    real_part_output->reserve(output_length_);
   }
   if (imaginary_part_output->capacity() <
-      static_cast<std::size_t>(fft_length_)) {
-    imaginary_part_output->reserve(fft_length_);
+      static_cast<std::size_t>(output_length_)) {
+    imaginary_part_output->reserve(output_length_);
   }
 
   // get values and fill zero
@@ -120,11 +128,113 @@ bool FastFourierTransformForRealSequence::Run(
                                    real_part_output, imaginary_part_output)) {
     return false;
   }
-  real_part_output->resize(fft_length_);
-  imaginary_part_output->resize(fft_length_);
+  real_part_output->resize(output_length_);
+  imaginary_part_output->resize(output_length_);
+
+  UnpackSpectrum(&((*real_part_output)[0]), &((*imaginary_part_output)[0]));
+
+  return true;
+}
+
+bool FastFourierTransformForRealSequence::Run(
+    const sptk::Matrix& real_part_input, sptk::Matrix* real_part_output,
+    sptk::Matrix* imaginary_part_output,
+    FastFourierTransformForRealSequence::Buffer* buffer) const {
+  // check inputs
+  const int num_frames(real_part_input.GetNumRow());
+  if (!is_valid_ || num_frames <= 0 ||
+      real_part_input.GetNumColumn() != num_order_ + 1 ||
+      NULL == real_part_output || NULL == imaginary_part_output ||
+      NULL == buffer) {
+    return false;
+  }
+
+  // prepare memories
+  if (buffer->real_part_inputs_.GetNumRow() != num_frames ||
+      buffer->real_part_inputs_.GetNumColumn() != half_fft_length_) {
+    buffer->real_part_inputs_.Resize(num_frames, half_fft_length_);
+  }
+  if (buffer->imaginary_part_inputs_.GetNumRow() != num_frames ||
+      buffer->imaginary_part_inputs_.GetNumColumn() != half_fft_length_) {
+    buffer->imaginary_part_inputs_.Resize(num_frames, half_fft_length_);
+  }
+  if (real_part_output->GetNumRow() != num_frames ||
+      real_part_output->GetNumColumn() != output_length_) {
+    real_part_output->Resize(num_frames, output_length_);
+  }
+  if (imaginary_part_output->GetNumRow() != num_frames ||
+      imaginary_part_output->GetNumColumn() != output_length_) {
+    imaginary_part_output->Resize(num_frames, output_length_);
+  }
+
+  // get values and fill zero
+  const int input_length(num_order_ + 1);
+  for (int f(0); f < num_frames; ++f) {
+    const double* input(real_part_input[f]);
+    double* x(buffer->real_part_inputs_[f]);
+    double* y(buffer->imaginary_part_inputs_[f]);
+    for (int i(0), j(0); i < input_length; ++j) {
+      x[j] = input[i++];
+      if (input_length <= i) break;
+      y[j] = input[i++];
+    }
+    std::fill(x + (input_length + 1) / 2, x + half_fft_length_, 0.0);
+    std::fill(y + input_length / 2, y + half_fft_length_, 0.0);
+  }
+
+  // run fast Fourier transform
+  if (!fast_fourier_transform_.Run(
+          buffer->real_part_inputs_, buffer->imaginary_part_inputs_,
+          &buffer->real_part_outputs_, &buffer->imaginary_part_outputs_)) {
+    return false;
+  }
+
+  for (int f(0); f < num_frames; ++f) {
+    double* x((*real_part_output)[f]);
+    double* y((*imaginary_part_output)[f]);
+    std::copy(buffer->real_part_outputs_[f],
+              buffer->real_part_outputs_[f] + half_fft_length_, x);
+    std::copy(buffer->imaginary_part_outputs_[f],
+              buffer->imaginary_part_outputs_[f] + half_fft_length_, y);
+    UnpackSpectrum(x, y);
+  }
+
+  return true;
+}
+
+// The first half of the arrays holds the spectrum of the real sequence
+// packed into a complex sequence Z of half length H. The spectrum X of the
+// real sequence is given by
+//   X(k) = (Z(k) + Z*(H-k)) / 2 - j W_N^k (Z(k) - Z*(H-k)) / 2,
+// and X(N-k) = X*(k).
+void FastFourierTransformForRealSequence::UnpackSpectrum(double* x,
+                                                         double* y) const {
+  if (half_length_output_) {
+    // Since X(k) and X(H-k) depend only on Z(k) and Z(H-k), both of them are
+    // computed in place at a time and the redundant bins are not touched.
+    x[half_fft_length_] = x[0] - y[0];
+    x[0] = x[0] + y[0];
+    y[half_fft_length_] = 0.0;
+    y[0] = 0.0;
+
+    const double* cosine_table(&(cosine_table_[0]));
+    const double* sine_table(&(sine_table_[0]));
+    for (int i(1), j(half_fft_length_ - 1); i <= j; ++i, --j) {
+      const double sum_x(x[i] + x[j]);
+      const double diff_x(x[i] - x[j]);
+      const double sum_y(y[i] + y[j]);
+      const double diff_y(y[i] - y[j]);
+      x[i] = (sum_x + cosine_table[i] * sum_y - sine_table[i] * diff_x) * 0.5;
+      y[i] = (diff_y - sine_table[i] * sum_y - cosine_table[i] * diff_x) * 0.5;
+      if (i != j) {
+        x[j] = (sum_x + cosine_table[j] * sum_y + sine_table[j] * diff_x) * 0.5;
+        y[j] =
+            (-diff_y - sine_table[j] * sum_y + cosine_table[j] * diff_x) * 0.5;
+      }
+    }
+    return;
+  }
 
-  double* x(&((*real_part_output)[0]));
-  double* y(&((*imaginary_part_output)[0]));
   double* xp(x);
   double* yp(y);
   double* xq(xp + fft_length_);
@@ -135,7 +245,7 @@ bool FastFourierTransformForRealSequence::Run(
   *yp = 0;
 
   double* sinp(const_cast<double*>(&(sine_table_[0])));
-  double* cosp(const_cast<double*>(&(sine_table_[0])) + fft_length_ / 4);
+  double* cosp(const_cast<double*>(&(cosine_table_[0])));
   for (int i(1), j(half_fft_length_ - 2); i < half_fft_length_; ++i, j -= 2) {
     ++xp;
     ++yp;
@@ -155,8 +265,6 @@ bool FastFourierTransformForRealSequence::Run(
     *xp++ = *(--xq);
     *yp++ = -(*(--yq));
   }
-
-  return true;
 }
 
 }  // namespace sptk
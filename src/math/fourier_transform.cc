@@ -44,7 +44,6 @@
 
 #include "SPTK/math/fourier_transform.h"
 
-#include "SPTK/math/discrete_fourier_transform.h"
 #include "SPTK/math/fast_fourier_transform.h"
 
 namespace {
@@ -73,41 +72,14 @@ class FastFourierTransformWrapper
   DISALLOW_COPY_AND_ASSIGN(FastFourierTransformWrapper);
 };
 
-class DiscreteFourierTransformWrapper
-    : public sptk::FourierTransform::FourierTransformInterface {
- public:
-  explicit DiscreteFourierTransformWrapper(int dft_length)
-      : discrete_fourier_tranform_(dft_length) {
-  }
-  virtual ~DiscreteFourierTransformWrapper() {
-  }
-  virtual bool IsValid() const {
-    return discrete_fourier_tranform_.IsValid();
-  }
-  virtual bool Run(const std::vector<double>& real_part_input,
-                   const std::vector<double>& imaginary_part_input,
-                   std::vector<double>* real_part_output,
-                   std::vector<double>* imaginary_part_output) const {
-    return discrete_fourier_tranform_.Run(real_part_input, imaginary_part_input,
-                                          real_part_output,
-                                          imaginary_part_output);
-  }
-
- private:
-  const sptk::DiscreteFourierTransform discrete_fourier_tranform_;
-  DISALLOW_COPY_AND_ASSIGN(DiscreteFourierTransformWrapper);
-};
-
 }  // namespace
 
 namespace sptk {
 
+// The fast Fourier transform handles arbitrary lengths by the mixed-radix
+// and Bluestein's algorithms.
 FourierTransform::FourierTransform(int data_length) {
-  if (sptk::IsPowerOfTwo(data_length)) {
-    fourier_transform_ = new FastFourierTransformWrapper(data_length);
-  } else {
-    fourier_transform_ = new DiscreteFourierTransformWrapper(data_length);
-  }
+  fourier_transform_ = new FastFourierTransformWrapper(data_length);
 }
 
 }  // namespace sptk
@@ -44,20 +44,68 @@
 
 #include "SPTK/math/frequency_transform.h"
 
-#include <algorithm>  // std::copy, std::fill
+#include <algorithm>  // std::copy, std::fill, std::min
 #include <cstddef>    // std::size_t
+#include <vector>     // std::vector
+
+namespace {
+
+// 32 MB in double precision.
+const int kMaxWarpingMatrixSize(1 << 22);
+
+}  // namespace
 
 namespace sptk {
 
 FrequencyTransform::FrequencyTransform(int num_input_order,
                                        int num_output_order, double alpha)
+    : FrequencyTransform(num_input_order, num_output_order, alpha, false) {
+}
+
+FrequencyTransform::FrequencyTransform(int num_input_order,
+                                       int num_output_order, double alpha,
+                                       bool use_warping_matrix)
     : num_input_order_(num_input_order),
       num_output_order_(num_output_order),
       alpha_(alpha),
+      use_warping_matrix_(false),
       is_valid_(true) {
   if (num_input_order_ < 0 || num_output_order_ < 0) {
     is_valid_ = false;
+    return;
   }
+
+  // The transform with zero all-pass constant is only a copy.
+  const int input_length(num_input_order_ + 1);
+  const int output_length(num_output_order_ + 1);
+  if (!use_warping_matrix || 0.0 == alpha_ ||
+      kMaxWarpingMatrixSize / output_length < input_length) {
+    return;
+  }
+
+  // The recursion adds the i-th input to g[0] and then updates g i times
+  // without input. Thus the i-th row of the matrix is the i-th power of the
+  // update applied to the unit vector.
+  warping_matrix_.Resize(input_length, output_length);
+  const double beta(1.0 - alpha_ * alpha_);
+  std::vector<double> d(output_length);
+  std::vector<double> g(output_length, 0.0);
+  g[0] = 1.0;
+  std::copy(g.begin(), g.end(), warping_matrix_[0]);
+  for (int i(1); i < input_length; ++i) {
+    d[0] = g[0];
+    g[0] = alpha_ * d[0];
+    if (1 <= num_output_order_) {
+      d[1] = g[1];
+      g[1] = beta * d[0] + alpha_ * d[1];
+    }
+    for (int j(2); j <= num_output_order_; ++j) {
+      d[j] = g[j];
+      g[j] = d[j - 1] + alpha_ * (d[j] - g[j - 1]);
+    }
+    std::copy(g.begin(), g.end(), warping_matrix_[i]);
+  }
+  use_warping_matrix_ = true;
 }
 
 bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
@@ -92,7 +140,67 @@ bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
     return true;
   }
 
+  // transform
+  if (use_warping_matrix_) {
+    RunMatrixVectorProduct(&(minimum_phase_sequence[0]),
+                           &((*warped_sequence)[0]));
+  } else {
+    RunRecursion(&(minimum_phase_sequence[0]), &((*warped_sequence)[0]),
+                 buffer);
+  }
+
+  return true;
+}
+
+bool FrequencyTransform::Run(const sptk::Matrix& minimum_phase_sequences,
+                             sptk::Matrix* warped_sequences,
+                             FrequencyTransform::Buffer* buffer) const {
+  // check inputs
+  const int num_frames(minimum_phase_sequences.GetNumRow());
+  const int input_length(num_input_order_ + 1);
+  if (!is_valid_ || num_frames <= 0 ||
+      minimum_phase_sequences.GetNumColumn() != input_length ||
+      NULL == warped_sequences || NULL == buffer) {
+    return false;
+  }
+
+  // the product sums each element in the same order as the single frame one
+  if (use_warping_matrix_) {
+    return minimum_phase_sequences.Multiply(warping_matrix_, warped_sequences);
+  }
+
+  // prepare memory
+  const int output_length(num_output_order_ + 1);
+  if (warped_sequences->GetNumRow() != num_frames ||
+      warped_sequences->GetNumColumn() != output_length) {
+    warped_sequences->Resize(num_frames, output_length);
+  }
+
+  // handle specific case
+  if (0.0 == alpha_) {
+    const int copy_length(std::min(input_length, output_length));
+    for (int t(0); t < num_frames; ++t) {
+      std::copy(minimum_phase_sequences[t],
+                minimum_phase_sequences[t] + copy_length,
+                (*warped_sequences)[t]);
+      std::fill((*warped_sequences)[t] + copy_length,
+                (*warped_sequences)[t] + output_length, 0.0);
+    }
+    return true;
+  }
+
+  // transform
+  for (int t(0); t < num_frames; ++t) {
+    RunRecursion(minimum_phase_sequences[t], (*warped_sequences)[t], buffer);
+  }
+
+  return true;
+}
+
+void FrequencyTransform::RunRecursion(const double* input, double* output,
+                                      FrequencyTransform::Buffer* buffer) const {
   // prepare buffer
+  const int output_length(num_output_order_ + 1);
   if (buffer->d_.size() != static_cast<std::size_t>(output_length)) {
     buffer->d_.resize(output_length);
   }
@@ -101,7 +209,6 @@ bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
   }
 
   // get values
-  const double* input(&(minimum_phase_sequence[0]));
   double* d(&buffer->d_[0]);
   double* g(&buffer->g_[0]);
 
@@ -126,9 +233,22 @@ bool FrequencyTransform::Run(const std::vector<double>& minimum_phase_sequence,
   }
 
   // save results
-  std::copy(buffer->g_.begin(), buffer->g_.end(), warped_sequence->begin());
+  std::copy(buffer->g_.begin(), buffer->g_.end(), output);
+}
 
-  return true;
+void FrequencyTransform::RunMatrixVectorProduct(const double* input,
+                                                double* output) const {
+  // Accumulate scaled rows so that the inner loop runs over contiguous memory
+  // without any dependency between iterations.
+  const int output_length(num_output_order_ + 1);
+  std::fill(output, output + output_length, 0.0);
+  for (int i(0); i <= num_input_order_; ++i) {
+    const double x(input[i]);
+    const double* w(warping_matrix_[i]);
+    for (int j(0); j < output_length; ++j) {
+      output[j] += x * w[j];
+    }
+  }
 }
 
 }  // namespace sptk
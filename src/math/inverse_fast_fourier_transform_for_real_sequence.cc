@@ -55,6 +55,12 @@ InverseFastFourierTransformForRealSequence::
     : fast_fourier_transform_(num_order, fft_length) {
 }
 
+InverseFastFourierTransformForRealSequence::
+    InverseFastFourierTransformForRealSequence(int num_order, int fft_length,
+                                               bool half_length_output)
+    : fast_fourier_transform_(num_order, fft_length, half_length_output) {
+}
+
 bool InverseFastFourierTransformForRealSequence::Run(
     const std::vector<double>& real_part_input,
     std::vector<double>* real_part_output,
@@ -75,14 +81,14 @@ bool InverseFastFourierTransformForRealSequence::Run(
     return false;
   }
 
-  const int fft_length(fast_fourier_transform_.GetFftLength());
-  const double inverse_fft_length(1.0 / fft_length);
+  const int output_length(fast_fourier_transform_.GetOutputLength());
+  const double inverse_fft_length(1.0 / fast_fourier_transform_.GetFftLength());
   std::transform(real_part_output->begin(),
-                 real_part_output->begin() + fft_length,
+                 real_part_output->begin() + output_length,
                  real_part_output->begin(),
                  std::bind1st(std::multiplies<double>(), inverse_fft_length));
   std::transform(imaginary_part_output->begin(),
-                 imaginary_part_output->begin() + fft_length,
+                 imaginary_part_output->begin() + output_length,
                  imaginary_part_output->begin(),
                  std::bind1st(std::multiplies<double>(), inverse_fft_length));
 
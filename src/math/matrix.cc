@@ -44,7 +44,7 @@
 
 #include "SPTK/math/matrix.h"
 
-#include <algorithm>  // std::fill, std::transform
+#include <algorithm>  // std::fill, std::min, std::transform
 #include <stdexcept>  // std::logic_error, std::out_of_range
 #include <string>     // std::string
 
@@ -54,6 +54,105 @@ const std::string kErrorMessageForOutOfRange("Matrix: Out of range");
 const std::string kErrorMessageForLogicError(
     "Matrix: Matrix sizes do not match");
 
+// Block sizes of matrix multiplication. A block of the right-hand side matrix
+// (kBlockSizeOfInnerDimension x kBlockSizeOfColumn) stays in the L2 cache.
+const int kBlockSizeOfInnerDimension(128);
+const int kBlockSizeOfColumn(256);
+
+// Size of the tile at which the recursion of transposition stops.
+const int kTileSizeOfTransposition(16);
+
+// Add a(i0:i0+4, k0:k1) * b(k0:k1, j0:j0+4) to c(i0:i0+4, j0:j0+4). Each
+// element is accumulated in the ascending order of k.
+void MultiplyBlockOfFourByFour(const double* const* a, const double* const* b,
+                               int i0, int j0, int k0, int k1,
+                               double* const* c) {
+  const double* a0(a[i0]);
+  const double* a1(a[i0 + 1]);
+  const double* a2(a[i0 + 2]);
+  const double* a3(a[i0 + 3]);
+  double c00(c[i0][j0]), c01(c[i0][j0 + 1]);
+  double c02(c[i0][j0 + 2]), c03(c[i0][j0 + 3]);
+  double c10(c[i0 + 1][j0]), c11(c[i0 + 1][j0 + 1]);
+  double c12(c[i0 + 1][j0 + 2]), c13(c[i0 + 1][j0 + 3]);
+  double c20(c[i0 + 2][j0]), c21(c[i0 + 2][j0 + 1]);
+  double c22(c[i0 + 2][j0 + 2]), c23(c[i0 + 2][j0 + 3]);
+  double c30(c[i0 + 3][j0]), c31(c[i0 + 3][j0 + 1]);
+  double c32(c[i0 + 3][j0 + 2]), c33(c[i0 + 3][j0 + 3]);
+  for (int k(k0); k < k1; ++k) {
+    const double* b_k(b[k] + j0);
+    const double b0(b_k[0]), b1(b_k[1]), b2(b_k[2]), b3(b_k[3]);
+    const double a0k(a0[k]), a1k(a1[k]), a2k(a2[k]), a3k(a3[k]);
+    c00 += a0k * b0;
+    c01 += a0k * b1;
+    c02 += a0k * b2;
+    c03 += a0k * b3;
+    c10 += a1k * b0;
+    c11 += a1k * b1;
+    c12 += a1k * b2;
+    c13 += a1k * b3;
+    c20 += a2k * b0;
+    c21 += a2k * b1;
+    c22 += a2k * b2;
+    c23 += a2k * b3;
+    c30 += a3k * b0;
+    c31 += a3k * b1;
+    c32 += a3k * b2;
+    c33 += a3k * b3;
+  }
+  c[i0][j0] = c00;
+  c[i0][j0 + 1] = c01;
+  c[i0][j0 + 2] = c02;
+  c[i0][j0 + 3] = c03;
+  c[i0 + 1][j0] = c10;
+  c[i0 + 1][j0 + 1] = c11;
+  c[i0 + 1][j0 + 2] = c12;
+  c[i0 + 1][j0 + 3] = c13;
+  c[i0 + 2][j0] = c20;
+  c[i0 + 2][j0 + 1] = c21;
+  c[i0 + 2][j0 + 2] = c22;
+  c[i0 + 2][j0 + 3] = c23;
+  c[i0 + 3][j0] = c30;
+  c[i0 + 3][j0 + 1] = c31;
+  c[i0 + 3][j0 + 2] = c32;
+  c[i0 + 3][j0 + 3] = c33;
+}
+
+// Add a(i, k0:k1) * b(k0:k1, j) to c(i, j).
+void MultiplyElement(const double* const* a, const double* const* b, int i,
+                     int j, int k0, int k1, double* const* c) {
+  const double* a_i(a[i]);
+  double sum(c[i][j]);
+  for (int k(k0); k < k1; ++k) {
+    sum += a_i[k] * b[k][j];
+  }
+  c[i][j] = sum;
+}
+
+// Transpose x(i0:i1, j0:j1) to y by recursively halving the longer side.
+void TransposeRecursively(const double* const* x, int i0, int i1, int j0,
+                          int j1, double* const* y) {
+  const int num_row(i1 - i0);
+  const int num_column(j1 - j0);
+  if (num_row <= kTileSizeOfTransposition &&
+      num_column <= kTileSizeOfTransposition) {
+    for (int i(i0); i < i1; ++i) {
+      const double* x_i(x[i]);
+      for (int j(j0); j < j1; ++j) {
+        y[j][i] = x_i[j];
+      }
+    }
+  } else if (num_column <= num_row) {
+    const int i_mid(i0 + num_row / 2);
+    TransposeRecursively(x, i0, i_mid, j0, j1, y);
+    TransposeRecursively(x, i_mid, i1, j0, j1, y);
+  } else {
+    const int j_mid(j0 + num_column / 2);
+    TransposeRecursively(x, i0, i1, j0, j_mid, y);
+    TransposeRecursively(x, i0, i1, j_mid, j1, y);
+  }
+}
+
 }  // namespace
 
 namespace sptk {
@@ -155,14 +254,58 @@ Matrix Matrix::operator*(const Matrix& matrix) const {
     throw std::logic_error(kErrorMessageForLogicError);
   }
   Matrix result(num_row_, matrix.num_column_);
-  for (int i(0); i < num_row_; ++i) {
-    for (int j(0); j < matrix.num_column_; ++j) {
-      for (int k(0); k < num_column_; ++k) {
-        result.index_[i][j] += index_[i][k] * matrix.index_[k][j];
+  Multiply(matrix, &result);
+  return result;
+}
+
+bool Matrix::Multiply(const Matrix& matrix, Matrix* product) const {
+  if (num_column_ != matrix.num_row_ || NULL == product || this == product ||
+      &matrix == product) {
+    return false;
+  }
+
+  if (product->num_row_ != num_row_ ||
+      product->num_column_ != matrix.num_column_) {
+    product->Resize(num_row_, matrix.num_column_);
+  } else {
+    product->FillZero();
+  }
+
+  const int num_row(num_row_);
+  const int num_column(matrix.num_column_);
+  const int num_inner(num_column_);
+  if (0 == num_row || 0 == num_column || 0 == num_inner) {
+    return true;
+  }
+  const double* const* a(&(index_[0]));
+  const double* const* b(&(matrix.index_[0]));
+  double* const* c(&(product->index_[0]));
+
+  for (int k0(0); k0 < num_inner; k0 += kBlockSizeOfInnerDimension) {
+    const int k1(std::min(k0 + kBlockSizeOfInnerDimension, num_inner));
+    for (int j0(0); j0 < num_column; j0 += kBlockSizeOfColumn) {
+      const int j1(std::min(j0 + kBlockSizeOfColumn, num_column));
+      const int j1_of_blocks(j0 + (j1 - j0) / 4 * 4);
+      int i(0);
+      for (; i + 4 <= num_row; i += 4) {
+        for (int j(j0); j < j1_of_blocks; j += 4) {
+          MultiplyBlockOfFourByFour(a, b, i, j, k0, k1, c);
+        }
+        for (int r(i); r < i + 4; ++r) {
+          for (int j(j1_of_blocks); j < j1; ++j) {
+            MultiplyElement(a, b, r, j, k0, k1, c);
+          }
+        }
+      }
+      for (; i < num_row; ++i) {
+        for (int j(j0); j < j1; ++j) {
+          MultiplyElement(a, b, i, j, k0, k1, c);
+        }
       }
     }
   }
-  return result;
+
+  return true;
 }
 
 void Matrix::FillZero() {
@@ -179,10 +322,9 @@ bool Matrix::Transpose(Matrix* transposed_matrix) const {
     transposed_matrix->Resize(num_column_, num_row_);
   }
 
-  for (int i(0); i < num_column_; ++i) {
-    for (int j(0); j < num_row_; ++j) {
-      transposed_matrix->index_[i][j] = index_[j][i];
-    }
+  if (0 < num_row_ && 0 < num_column_) {
+    TransposeRecursively(&(index_[0]), 0, num_row_, 0, num_column_,
+                         &(transposed_matrix->index_[0]));
   }
 
   return true;
@@ -44,22 +44,338 @@
 
 #include "SPTK/math/principal_component_analysis.h"
 
-#include <algorithm>  // std::sort, std::swap
-#include <cmath>      // std::fabs, std::sqrt
+#include <algorithm>  // std::copy, std::max, std::min, std::sort, std::swap
+#include <cfloat>     // DBL_EPSILON, DBL_MIN
+#include <cmath>      // std::fabs, std::hypot, std::sqrt
 #include <cstddef>    // std::size_t
 #include <numeric>    // std::iota
 
+#include "SPTK/generator/normal_distributed_random_value_generation.h"
+
+namespace {
+
+// The number of vectors passed to the statistics accumulator at once.
+const int kNumVectorInBlock(256);
+
+// The number of basis vectors used in subspace iteration in addition to the
+// principal components to be computed. They speed up the convergence.
+const int kMinNumAdditionalBasisVector(10);
+
+// Seed for the initial basis vectors of subspace iteration.
+const int kSeed(1);
+
+// Reduce the symmetric matrix a to a tridiagonal matrix by Householder
+// transformations. On output, the columns of a hold the orthogonal matrix
+// accumulating the transformations, d holds the diagonal elements, and e holds
+// the subdiagonal elements with e[0] = 0.
+void Tridiagonalize(sptk::Matrix* a, std::vector<double>* d,
+                    std::vector<double>* e) {
+  sptk::Matrix& v(*a);
+  const int n(v.GetNumRow());
+
+  for (int j(0); j < n; ++j) {
+    (*d)[j] = v[n - 1][j];
+  }
+
+  for (int i(n - 1); 0 < i; --i) {
+    double scale(0.0);
+    double h(0.0);
+    for (int k(0); k < i; ++k) {
+      scale += std::fabs((*d)[k]);
+    }
+    if (0.0 == scale) {
+      (*e)[i] = (*d)[i - 1];
+      for (int j(0); j < i; ++j) {
+        (*d)[j] = v[i - 1][j];
+        v[i][j] = 0.0;
+        v[j][i] = 0.0;
+      }
+    } else {
+      // generate Householder vector
+      for (int k(0); k < i; ++k) {
+        (*d)[k] /= scale;
+        h += (*d)[k] * (*d)[k];
+      }
+      double f((*d)[i - 1]);
+      double g(std::sqrt(h));
+      if (0.0 < f) g = -g;
+      (*e)[i] = scale * g;
+      h -= f * g;
+      (*d)[i - 1] = f - g;
+      for (int j(0); j < i; ++j) {
+        (*e)[j] = 0.0;
+      }
+
+      // apply similarity transformation to remaining columns
+      for (int j(0); j < i; ++j) {
+        f = (*d)[j];
+        v[j][i] = f;
+        g = (*e)[j] + v[j][j] * f;
+        for (int k(j + 1); k < i; ++k) {
+          g += v[k][j] * (*d)[k];
+          (*e)[k] += v[k][j] * f;
+        }
+        (*e)[j] = g;
+      }
+      f = 0.0;
+      for (int j(0); j < i; ++j) {
+        (*e)[j] /= h;
+        f += (*e)[j] * (*d)[j];
+      }
+      const double hh(f / (h + h));
+      for (int j(0); j < i; ++j) {
+        (*e)[j] -= hh * (*d)[j];
+      }
+      for (int j(0); j < i; ++j) {
+        f = (*d)[j];
+        g = (*e)[j];
+        for (int k(j); k < i; ++k) {
+          v[k][j] -= (f * (*e)[k] + g * (*d)[k]);
+        }
+        (*d)[j] = v[i - 1][j];
+        v[i][j] = 0.0;
+      }
+    }
+    (*d)[i] = h;
+  }
+
+  // accumulate transformations
+  for (int i(0); i < n - 1; ++i) {
+    v[n - 1][i] = v[i][i];
+    v[i][i] = 1.0;
+    const double h((*d)[i + 1]);
+    if (0.0 != h) {
+      for (int k(0); k <= i; ++k) {
+        (*d)[k] = v[k][i + 1] / h;
+      }
+      for (int j(0); j <= i; ++j) {
+        double g(0.0);
+        for (int k(0); k <= i; ++k) {
+          g += v[k][i + 1] * v[k][j];
+        }
+        for (int k(0); k <= i; ++k) {
+          v[k][j] -= g * (*d)[k];
+        }
+      }
+    }
+    for (int k(0); k <= i; ++k) {
+      v[k][i + 1] = 0.0;
+    }
+  }
+  for (int j(0); j < n; ++j) {
+    (*d)[j] = v[n - 1][j];
+    v[n - 1][j] = 0.0;
+  }
+  v[n - 1][n - 1] = 1.0;
+  (*e)[0] = 0.0;
+}
+
+// Diagonalize the tridiagonal matrix given by d and e using the QL algorithm
+// with implicit shifts. The rows of u are rotated along with the matrix, so
+// if u holds the transposed output of Tridiagonalize, the i-th row of u is the
+// eigenvector corresponding to the eigenvalue d[i] on output.
+bool Diagonalize(int num_iteration, std::vector<double>* d,
+                 std::vector<double>* e, sptk::Matrix* u) {
+  const int n(u->GetNumRow());
+
+  for (int i(1); i < n; ++i) {
+    (*e)[i - 1] = (*e)[i];
+  }
+  (*e)[n - 1] = 0.0;
+
+  double f(0.0);
+  double tst1(0.0);
+  for (int l(0); l < n; ++l) {
+    // find small subdiagonal element
+    tst1 = std::max(tst1, std::fabs((*d)[l]) + std::fabs((*e)[l]));
+    int m(l);
+    while (m < n) {
+      if (std::fabs((*e)[m]) <= DBL_EPSILON * tst1) break;
+      ++m;
+    }
+
+    // if m == l, d[l] is already an eigenvalue; otherwise, iterate
+    if (l < m) {
+      int iteration(0);
+      do {
+        if (num_iteration <= iteration++) {
+          return false;
+        }
+
+        // compute implicit shift
+        double g((*d)[l]);
+        double p(((*d)[l + 1] - g) / (2.0 * (*e)[l]));
+        double r(std::hypot(p, 1.0));
+        if (p < 0.0) r = -r;
+        (*d)[l] = (*e)[l] / (p + r);
+        (*d)[l + 1] = (*e)[l] * (p + r);
+        const double dl1((*d)[l + 1]);
+        double h(g - (*d)[l]);
+        for (int i(l + 2); i < n; ++i) {
+          (*d)[i] -= h;
+        }
+        f += h;
+
+        // implicit QL transformation
+        p = (*d)[m];
+        double c(1.0), c2(1.0), c3(1.0);
+        const double el1((*e)[l + 1]);
+        double s(0.0), s2(0.0);
+        for (int i(m - 1); l <= i; --i) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * (*e)[i];
+          h = c * p;
+          r = std::hypot(p, (*e)[i]);
+          (*e)[i + 1] = s * r;
+          s = (*e)[i] / r;
+          c = p / r;
+          p = c * (*d)[i] - s * g;
+          (*d)[i + 1] = h + s * (c * g + s * (*d)[i]);
+
+          // accumulate transformation
+          double* u_i((*u)[i]);
+          double* u_i1((*u)[i + 1]);
+          for (int k(0); k < n; ++k) {
+            const double w(u_i1[k]);
+            u_i1[k] = s * u_i[k] + c * w;
+            u_i[k] = c * u_i[k] - s * w;
+          }
+        }
+        p = -s * s2 * c3 * el1 * (*e)[l] / dl1;
+        (*e)[l] = s * p;
+        (*d)[l] = c * p;
+      } while (DBL_EPSILON * tst1 < std::fabs((*e)[l]));
+    }
+    (*d)[l] += f;
+    (*e)[l] = 0.0;
+  }
+
+  return true;
+}
+
+// Compute all eigenvalues and eigenvectors of the symmetric matrix a. On
+// output, the i-th row of a is the eigenvector corresponding to the eigenvalue
+// (*eigenvalues)[i]. The eigenvalues are not sorted.
+bool DecomposeSymmetricMatrix(int num_iteration, sptk::Matrix* a,
+                              std::vector<double>* eigenvalues,
+                              std::vector<double>* work) {
+  const int n(a->GetNumRow());
+  if (eigenvalues->size() != static_cast<std::size_t>(n)) {
+    eigenvalues->resize(n);
+  }
+  if (work->size() != static_cast<std::size_t>(n)) {
+    work->resize(n);
+  }
+
+  Tridiagonalize(a, eigenvalues, work);
+  for (int i(0); i < n; ++i) {
+    for (int j(i + 1); j < n; ++j) {
+      std::swap((*a)[i][j], (*a)[j][i]);
+    }
+  }
+  return Diagonalize(num_iteration, eigenvalues, work, a);
+}
+
+// Flip the sign of the vector x so that its component of the largest magnitude
+// is positive. The sign of an eigenvector is otherwise arbitrary and depends
+// on the algorithm.
+void NormalizeSign(int length, double* x) {
+  int max_index(0);
+  for (int k(1); k < length; ++k) {
+    if (std::fabs(x[max_index]) < std::fabs(x[k])) {
+      max_index = k;
+    }
+  }
+  if (x[max_index] < 0.0) {
+    for (int k(0); k < length; ++k) {
+      x[k] = -x[k];
+    }
+  }
+}
+
+// Sort the indices of eigenvalues in descending order of the eigenvalues.
+void SortEigenvalues(const std::vector<double>& eigenvalues,
+                     std::vector<int>* order) {
+  if (order->size() != eigenvalues.size()) {
+    order->resize(eigenvalues.size());
+  }
+  std::iota(order->begin(), order->end(), 0);
+  std::sort(order->begin(), order->end(), [&eigenvalues](int i, int j) {
+    return eigenvalues[j] < eigenvalues[i];
+  });
+}
+
+// Orthonormalize the rows of x by modified Gram-Schmidt process with
+// reorthogonalization. A row which is linearly dependent on the preceding rows
+// is replaced with a random vector.
+void OrthonormalizeRows(sptk::NormalDistributedRandomValueGeneration* generator,
+                        sptk::Matrix* x) {
+  const int num_row(x->GetNumRow());
+  const int num_column(x->GetNumColumn());
+  for (int i(0); i < num_row; ++i) {
+    double* x_i((*x)[i]);
+    double original_norm(0.0);
+    for (int k(0); k < num_column; ++k) {
+      original_norm += x_i[k] * x_i[k];
+    }
+    original_norm = std::sqrt(original_norm);
+
+    for (int trial(0);; ++trial) {
+      for (int pass(0); pass < 2; ++pass) {
+        for (int j(0); j < i; ++j) {
+          const double* x_j((*x)[j]);
+          double inner_product(0.0);
+          for (int k(0); k < num_column; ++k) {
+            inner_product += x_i[k] * x_j[k];
+          }
+          for (int k(0); k < num_column; ++k) {
+            x_i[k] -= inner_product * x_j[k];
+          }
+        }
+      }
+
+      double norm(0.0);
+      for (int k(0); k < num_column; ++k) {
+        norm += x_i[k] * x_i[k];
+      }
+      norm = std::sqrt(norm);
+
+      if (DBL_MIN < norm && (DBL_EPSILON * original_norm < norm || 0 < trial)) {
+        const double z(1.0 / norm);
+        for (int k(0); k < num_column; ++k) {
+          x_i[k] *= z;
+        }
+        break;
+      }
+
+      for (int k(0); k < num_column; ++k) {
+        generator->Get(&(x_i[k]));
+      }
+      original_norm = 0.0;
+    }
+  }
+}
+
+}  // namespace
+
 namespace sptk {
 
 PrincipalComponentAnalysis::PrincipalComponentAnalysis(
-    int num_order, int num_iteration, double convergence_threshold)
+    int num_order, int num_principal_component, int num_iteration,
+    double convergence_threshold, Algorithms algorithm)
     : num_order_(num_order),
+      num_principal_component_(num_principal_component),
       num_iteration_(num_iteration),
       convergence_threshold_(convergence_threshold),
+      algorithm_(algorithm),
       accumulator_(num_order, 2),
       is_valid_(true) {
-  if (num_order_ < 0 || num_iteration_ <= 0 || convergence_threshold_ < 0.0 ||
-      !accumulator_.IsValid()) {
+  if (num_order_ < 0 || num_principal_component_ <= 0 ||
+      num_order_ + 1 < num_principal_component_ || num_iteration_ <= 0 ||
+      convergence_threshold_ < 0.0 || algorithm_ < 0 ||
+      kNumAlgorithms <= algorithm_ || !accumulator_.IsValid()) {
     is_valid_ = false;
   }
 }
@@ -74,26 +390,64 @@ bool PrincipalComponentAnalysis::Run(
     return false;
   }
 
+  // calculate statistics
+  Clear(buffer);
+  {
+    const int length(num_order_ + 1);
+    const int num_input_vector(input_vectors.size());
+    Matrix block_of_input_vectors;
+    for (int begin(0); begin < num_input_vector; begin += kNumVectorInBlock) {
+      const int block_size(
+          std::min(kNumVectorInBlock, num_input_vector - begin));
+      if (block_of_input_vectors.GetNumRow() != block_size) {
+        block_of_input_vectors.Resize(block_size, length);
+      }
+      for (int i(0); i < block_size; ++i) {
+        if (input_vectors[begin + i].size() !=
+            static_cast<std::size_t>(length)) {
+          return false;
+        }
+        std::copy(input_vectors[begin + i].begin(),
+                  input_vectors[begin + i].end(), block_of_input_vectors[i]);
+      }
+      if (!Run(block_of_input_vectors, buffer)) {
+        return false;
+      }
+    }
+  }
+
+  return Decompose(mean_vector, eigenvalues, eigenvector_matrix, buffer);
+}
+
+bool PrincipalComponentAnalysis::Run(
+    const Matrix& input_vectors,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  if (!is_valid_ || NULL == buffer) {
+    return false;
+  }
+  return accumulator_.Run(input_vectors, &buffer->accumulator_buffer_);
+}
+
+bool PrincipalComponentAnalysis::Decompose(
+    std::vector<double>* mean_vector, std::vector<double>* eigenvalues,
+    Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  if (!is_valid_ || NULL == mean_vector || NULL == eigenvalues ||
+      NULL == eigenvector_matrix || NULL == buffer) {
+    return false;
+  }
+
   // prepare memory
   const int length(num_order_ + 1);
-  if (eigenvector_matrix->GetNumRow() != length ||
+  if (eigenvector_matrix->GetNumRow() != num_principal_component_ ||
       eigenvector_matrix->GetNumColumn() != length) {
-    eigenvector_matrix->Resize(length, length);
-  }
-  if (eigenvalues->size() != static_cast<std::size_t>(length)) {
-    eigenvalues->resize(length);
+    eigenvector_matrix->Resize(num_principal_component_, length);
   }
-  if (buffer->eigenvalue_order_.size() != static_cast<std::size_t>(length)) {
-    buffer->eigenvalue_order_.resize(length);
+  if (eigenvalues->size() !=
+      static_cast<std::size_t>(num_principal_component_)) {
+    eigenvalues->resize(num_principal_component_);
   }
 
-  // calculate statistics
-  accumulator_.Clear(&buffer->accumulator_buffer_);
-  for (std::vector<double> input_vector : input_vectors) {
-    if (!accumulator_.Run(input_vector, &buffer->accumulator_buffer_)) {
-      return false;
-    }
-  }
   if (!accumulator_.GetMean(buffer->accumulator_buffer_, mean_vector)) {
     return false;
   }
@@ -102,101 +456,166 @@ bool PrincipalComponentAnalysis::Run(
     return false;
   }
 
-  // initialize with identity matrix
+  // copy covariance matrix
+  if (buffer->b_.GetNumRow() != length) {
+    buffer->b_.Resize(length, length);
+  }
   for (int i(0); i < length; ++i) {
-    for (int j(0); j < length; ++j) {
-      (*eigenvector_matrix)[i][j] = (i == j) ? 1.0 : 0.0;
+    for (int j(0); j <= i; ++j) {
+      buffer->b_[i][j] = buffer->b_[j][i] = buffer->a_[i][j];
     }
   }
 
-  // solve a set of linear equations using Jacobi iterative method
-  for (int n(0); n < num_iteration_; ++n) {
-    int p(0);
-    int q(0);
-    {
-      double off_diagonal_max(0.0);
-      for (int i(0); i < length; ++i) {
-        for (int j(i + 1); j < length; ++j) {
-          const double val(std::fabs(buffer->a_[i][j]));
-          if (off_diagonal_max < val) {
-            off_diagonal_max = val;
-            p = i;
-            q = j;
-          }
-        }
-      }
-      if (off_diagonal_max <= convergence_threshold_) {
-        break;
-      }
+  switch (algorithm_) {
+    case kHouseholderQl: {
+      return RunHouseholderQl(eigenvalues, eigenvector_matrix, buffer);
+    }
+    case kSubspaceIteration: {
+      return RunSubspaceIteration(eigenvalues, eigenvector_matrix, buffer);
+    }
+    default: {
+      break;
     }
+  }
 
-    const double a_pp(buffer->a_[p][p]);
-    const double a_qq(buffer->a_[q][q]);
-    const double a_pq(buffer->a_[p][q]);
+  return false;
+}
 
-    const double t1(std::fabs(a_pp - a_qq));
-    const double t2(2.0 * a_pq);
-    // the following equation can be derived from
-    //   theta = 1/2 * atan(2 * a_pq / (a_pp - a_qq)),
-    // using the double-angle formulas and the quadratic formula
-    const double tan_theta(t2 / (t1 + std::sqrt(t1 * t1 + t2 * t2)));
-    const double cos_theta(std::sqrt(1.0 / (tan_theta * tan_theta + 1.0)));
-    const double sin_theta((a_pp < a_qq) ? tan_theta * cos_theta
-                                         : -tan_theta * cos_theta);
+bool PrincipalComponentAnalysis::GetNumData(
+    const PrincipalComponentAnalysis::Buffer& buffer, int* num_data) const {
+  if (!is_valid_) {
+    return false;
+  }
+  return accumulator_.GetNumData(buffer.accumulator_buffer_, num_data);
+}
 
-    // update eigenvectors
-    for (int i(0); i < length; ++i) {
-      const double w1((*eigenvector_matrix)[p][i]);
-      const double w2((*eigenvector_matrix)[q][i]);
-      (*eigenvector_matrix)[p][i] = w1 * cos_theta - w2 * sin_theta;
-      (*eigenvector_matrix)[q][i] = w1 * sin_theta + w2 * cos_theta;
-    }
+bool PrincipalComponentAnalysis::GetTotalVariance(
+    const PrincipalComponentAnalysis::Buffer& buffer,
+    double* total_variance) const {
+  if (!is_valid_ || buffer.a_.GetNumDimension() != num_order_ + 1 ||
+      NULL == total_variance) {
+    return false;
+  }
 
-    for (int i(0); i < length; ++i) {
-      if (p != i && q != i) {
-        const double w1(buffer->a_[p][i]);
-        const double w2(buffer->a_[q][i]);
-        buffer->a_[p][i] = w1 * cos_theta - w2 * sin_theta;
-        buffer->a_[q][i] = w1 * sin_theta + w2 * cos_theta;
-      }
-    }
-    buffer->a_[p][p] = (a_pp * cos_theta * cos_theta) +
-                       (a_qq * sin_theta * sin_theta) -
-                       (2.0 * a_pq * cos_theta * sin_theta);
-    buffer->a_[q][q] = a_pp + a_qq - buffer->a_[p][p];
-    buffer->a_[p][q] = 0.0;
+  double sum(0.0);
+  for (int i(0); i <= num_order_; ++i) {
+    sum += buffer.a_[i][i];
   }
+  *total_variance = sum;
 
-  // sort eigenvalues in descending order
-  std::iota(buffer->eigenvalue_order_.begin(), buffer->eigenvalue_order_.end(),
-            0);
-  std::sort(
-      buffer->eigenvalue_order_.begin(), buffer->eigenvalue_order_.end(),
-      [&buffer](int i, int j) { return buffer->a_[j][j] < buffer->a_[i][i]; });
-  for (int i(0); i < length; ++i) {
-    (*eigenvalues)[i] =
-        buffer->a_[buffer->eigenvalue_order_[i]][buffer->eigenvalue_order_[i]];
+  return true;
+}
+
+bool PrincipalComponentAnalysis::RunHouseholderQl(
+    std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  if (!DecomposeSymmetricMatrix(num_iteration_, &buffer->b_,
+                                &buffer->eigenvalues_,
+                                &buffer->off_diagonal_elements_)) {
+    return false;
   }
 
-  // swap eigenvectors
-  for (int i(0); i < num_order_; ++i) {
-    int index(i);
-    while (index < length) {
-      if (buffer->eigenvalue_order_[index] == i) {
-        buffer->eigenvalue_order_[index] = buffer->eigenvalue_order_[i];
-        break;
+  SortEigenvalues(buffer->eigenvalues_, &buffer->eigenvalue_order_);
+  const int length(num_order_ + 1);
+  for (int i(0); i < num_principal_component_; ++i) {
+    const int j(buffer->eigenvalue_order_[i]);
+    (*eigenvalues)[i] = buffer->eigenvalues_[j];
+    std::copy(buffer->b_[j], buffer->b_[j] + length, (*eigenvector_matrix)[i]);
+    NormalizeSign(length, (*eigenvector_matrix)[i]);
+  }
+
+  return true;
+}
+
+bool PrincipalComponentAnalysis::RunSubspaceIteration(
+    std::vector<double>* eigenvalues, Matrix* eigenvector_matrix,
+    PrincipalComponentAnalysis::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+  const int num_basis_vector(std::min(
+      length, num_principal_component_ +
+                  std::max(num_principal_component_,
+                           kMinNumAdditionalBasisVector)));
+
+  // The rows of the matrices are treated as vectors, e.g., the covariance
+  // matrix A is applied to the basis vectors B as B A.
+  Matrix& a(buffer->b_);
+  Matrix& b(buffer->basis_vectors_);
+  Matrix& z(buffer->projected_vectors_);
+  Matrix& v(buffer->ritz_vectors_);
+  Matrix& av(buffer->projected_ritz_vectors_);
+  Matrix& t(buffer->rotation_matrix_);
+  Matrix& w(buffer->sorted_rotation_matrix_);
+  if (w.GetNumRow() != num_basis_vector) {
+    w.Resize(num_basis_vector, num_basis_vector);
+  }
+
+  // The basis vectors left by the previous call are reused as the initial
+  // guess. Otherwise, they are filled with zeros, which are then replaced with
+  // random vectors in the orthonormalization.
+  NormalDistributedRandomValueGeneration generator(kSeed);
+  if (b.GetNumRow() != num_basis_vector || b.GetNumColumn() != length) {
+    b.Resize(num_basis_vector, length);
+  }
+  OrthonormalizeRows(&generator, &b);
+
+  for (int n(0); n < num_iteration_; ++n) {
+    // Rayleigh-Ritz procedure on the subspace spanned by the basis vectors
+    if (!b.Multiply(a, &z) ||
+        !b.Transpose(&buffer->transposed_basis_vectors_) ||
+        !z.Multiply(buffer->transposed_basis_vectors_, &t)) {
+      return false;
+    }
+    for (int i(0); i < num_basis_vector; ++i) {
+      for (int j(0); j < i; ++j) {
+        t[i][j] = t[j][i] = 0.5 * (t[i][j] + t[j][i]);
       }
-      ++index;
+    }
+    if (!DecomposeSymmetricMatrix(num_iteration_, &t, &buffer->eigenvalues_,
+                                  &buffer->off_diagonal_elements_)) {
+      return false;
+    }
+    SortEigenvalues(buffer->eigenvalues_, &buffer->eigenvalue_order_);
+    for (int i(0); i < num_basis_vector; ++i) {
+      const double* t_j(t[buffer->eigenvalue_order_[i]]);
+      std::copy(t_j, t_j + num_basis_vector, w[i]);
+    }
+    if (!w.Multiply(b, &v) || !w.Multiply(z, &av)) {
+      return false;
     }
 
-    const int j(buffer->eigenvalue_order_[index]);
-    if (j != i) {
-      for (int k(0); k < length; ++k) {
-        std::swap((*eigenvector_matrix)[j][k], (*eigenvector_matrix)[i][k]);
+    // check residuals of the Ritz pairs
+    const double largest_eigenvalue(
+        std::fabs(buffer->eigenvalues_[buffer->eigenvalue_order_[0]]));
+    double max_residual(0.0);
+    for (int i(0); i < num_principal_component_; ++i) {
+      const double eigenvalue(
+          buffer->eigenvalues_[buffer->eigenvalue_order_[i]]);
+      double residual(0.0);
+      for (int j(0); j < length; ++j) {
+        const double diff(av[i][j] - eigenvalue * v[i][j]);
+        residual += diff * diff;
       }
+      max_residual = std::max(max_residual, std::sqrt(residual));
     }
+    if (max_residual <= convergence_threshold_ * largest_eigenvalue ||
+        num_basis_vector == length) {
+      break;
+    }
+
+    // update basis vectors
+    b = av;
+    OrthonormalizeRows(&generator, &b);
   }
 
+  for (int i(0); i < num_principal_component_; ++i) {
+    (*eigenvalues)[i] = buffer->eigenvalues_[buffer->eigenvalue_order_[i]];
+    std::copy(v[i], v[i] + length, (*eigenvector_matrix)[i]);
+    NormalizeSign(length, (*eigenvector_matrix)[i]);
+  }
+
+  // keep Ritz vectors for the next call
+  b = v;
+
   return true;
 }
 
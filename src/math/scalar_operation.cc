@@ -44,7 +44,8 @@
 
 #include "SPTK/math/scalar_operation.h"
 
-#include <cmath>  // std::exp, std::fabs, std::log, std::pow, std::sqrt, etc.
+#include <algorithm>  // std::fill_n
+#include <cmath>      // std::exp, std::fabs, std::log, std::pow, etc.
 
 namespace {
 
@@ -53,7 +54,15 @@ class OperationInterface {
   virtual ~OperationInterface() {
   }
 
-  virtual bool Run(double* number) const = 0;
+  virtual bool Run(int num_data, double* numbers) const = 0;
+
+  virtual bool MergeAddition(double) {
+    return false;
+  }
+
+  virtual bool MergeMultiplication(double) {
+    return false;
+  }
 };
 
 class OperationPerformer : public sptk::ScalarOperation::ModuleInterface {
@@ -66,76 +75,93 @@ class OperationPerformer : public sptk::ScalarOperation::ModuleInterface {
     delete operation_;
   }
 
-  virtual bool Run(double* number, bool* is_magic_number) const {
-    if (*is_magic_number) {
-      return true;
+  // Perform the operation on each run of numbers which are not magic numbers.
+  virtual bool Run(int num_data, double* numbers,
+                   bool* is_magic_numbers) const {
+    for (int i(0); i < num_data;) {
+      if (is_magic_numbers[i]) {
+        ++i;
+        continue;
+      }
+      int end(i + 1);
+      while (end < num_data && !is_magic_numbers[end]) {
+        ++end;
+      }
+      if (!operation_->Run(end - i, numbers + i)) {
+        return false;
+      }
+      i = end;
     }
-    return operation_->Run(number);
-  }
-
- private:
-  const OperationInterface* operation_;
-  DISALLOW_COPY_AND_ASSIGN(OperationPerformer);
-};
-
-class Addition : public OperationInterface {
- public:
-  explicit Addition(double addend) : addend_(addend) {
-  }
-
-  virtual bool Run(double* number) const {
-    *number += addend_;
     return true;
   }
 
- private:
-  const double addend_;
-  DISALLOW_COPY_AND_ASSIGN(Addition);
-};
-
-class Subtraction : public OperationInterface {
- public:
-  explicit Subtraction(double subtrahend) : subtrahend_(subtrahend) {
+  virtual bool MergeAddition(double addend) {
+    return operation_->MergeAddition(addend);
   }
 
-  virtual bool Run(double* number) const {
-    *number -= subtrahend_;
-    return true;
+  virtual bool MergeMultiplication(double multiplier) {
+    return operation_->MergeMultiplication(multiplier);
   }
 
  private:
-  const double subtrahend_;
-  DISALLOW_COPY_AND_ASSIGN(Subtraction);
+  OperationInterface* operation_;
+  DISALLOW_COPY_AND_ASSIGN(OperationPerformer);
 };
 
-class Multiplication : public OperationInterface {
+// Perform y = (x + addend) * multiplier + post_addend in one pass. Adjacent
+// additions, subtractions, multiplications, and divisions are merged into this
+// operation as long as they fit the form. No operation is reordered, so the
+// result is identical to that of performing them one by one. Unused terms are
+// set to the identity elements -0.0 and 1.0, which keep any number unchanged.
+class AffineTransformation : public OperationInterface {
  public:
-  explicit Multiplication(double multiplier) : multiplier_(multiplier) {
-  }
-
-  virtual bool Run(double* number) const {
-    *number *= multiplier_;
+  AffineTransformation()
+      : addend_(-0.0),
+        multiplier_(1.0),
+        post_addend_(-0.0),
+        has_addend_(false),
+        has_multiplier_(false),
+        has_post_addend_(false) {
+  }
+
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = (numbers[i] + addend_) * multiplier_ + post_addend_;
+    }
     return true;
   }
 
- private:
-  const double multiplier_;
-  DISALLOW_COPY_AND_ASSIGN(Multiplication);
-};
-
-class Division : public OperationInterface {
- public:
-  explicit Division(double divisor) : multiplier_(1.0 / divisor) {
+  virtual bool MergeAddition(double addend) {
+    if (!has_addend_ && !has_multiplier_) {
+      addend_ = addend;
+      has_addend_ = true;
+      return true;
+    }
+    if (has_multiplier_ && !has_post_addend_) {
+      post_addend_ = addend;
+      has_post_addend_ = true;
+      return true;
+    }
+    return false;
   }
 
-  virtual bool Run(double* number) const {
-    *number *= multiplier_;
-    return true;
+  virtual bool MergeMultiplication(double multiplier) {
+    if (!has_multiplier_ && !has_post_addend_) {
+      multiplier_ = multiplier;
+      has_multiplier_ = true;
+      return true;
+    }
+    return false;
   }
 
  private:
-  const double multiplier_;
-  DISALLOW_COPY_AND_ASSIGN(Division);
+  double addend_;
+  double multiplier_;
+  double post_addend_;
+  bool has_addend_;
+  bool has_multiplier_;
+  bool has_post_addend_;
+  DISALLOW_COPY_AND_ASSIGN(AffineTransformation);
 };
 
 class Modulo : public OperationInterface {
@@ -143,8 +169,10 @@ class Modulo : public OperationInterface {
   explicit Modulo(int divisor) : divisor_(divisor) {
   }
 
-  virtual bool Run(double* number) const {
-    *number = static_cast<int>(*number) % divisor_;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = static_cast<int>(numbers[i]) % divisor_;
+    }
     return true;
   }
 
@@ -158,8 +186,10 @@ class Power : public OperationInterface {
   explicit Power(double exponent) : exponent_(exponent) {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::pow(*number, exponent_);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::pow(numbers[i], exponent_);
+    }
     return true;
   }
 
@@ -173,8 +203,10 @@ class LowerBounding : public OperationInterface {
   explicit LowerBounding(double lower_bound) : lower_bound_(lower_bound) {
   }
 
-  virtual bool Run(double* number) const {
-    if (*number < lower_bound_) *number = lower_bound_;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = (numbers[i] < lower_bound_) ? lower_bound_ : numbers[i];
+    }
     return true;
   }
 
@@ -188,8 +220,10 @@ class UpperBounding : public OperationInterface {
   explicit UpperBounding(double upper_bound) : upper_bound_(upper_bound) {
   }
 
-  virtual bool Run(double* number) const {
-    if (upper_bound_ < *number) *number = upper_bound_;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = (upper_bound_ < numbers[i]) ? upper_bound_ : numbers[i];
+    }
     return true;
   }
 
@@ -203,8 +237,10 @@ class Absolute : public OperationInterface {
   Absolute() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::fabs(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::fabs(numbers[i]);
+    }
     return true;
   }
 
@@ -217,8 +253,10 @@ class Reciprocal : public OperationInterface {
   Reciprocal() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = 1.0 / *number;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = 1.0 / numbers[i];
+    }
     return true;
   }
 
@@ -231,8 +269,10 @@ class Square : public OperationInterface {
   Square() {
   }
 
-  virtual bool Run(double* number) const {
-    *number *= *number;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] *= numbers[i];
+    }
     return true;
   }
 
@@ -245,8 +285,10 @@ class SquareRoot : public OperationInterface {
   SquareRoot() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::sqrt(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::sqrt(numbers[i]);
+    }
     return true;
   }
 
@@ -259,8 +301,10 @@ class NaturalLogarithm : public OperationInterface {
   NaturalLogarithm() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::log(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::log(numbers[i]);
+    }
     return true;
   }
 
@@ -273,8 +317,10 @@ class Logarithm : public OperationInterface {
   explicit Logarithm(double base) : multiplier_(1.0 / std::log(base)) {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::log(*number) * multiplier_;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::log(numbers[i]) * multiplier_;
+    }
     return true;
   }
 
@@ -288,8 +334,10 @@ class NaturalExponential : public OperationInterface {
   NaturalExponential() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::exp(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::exp(numbers[i]);
+    }
     return true;
   }
 
@@ -302,8 +350,10 @@ class Exponential : public OperationInterface {
   explicit Exponential(double base) : base_(base) {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::pow(base_, *number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::pow(base_, numbers[i]);
+    }
     return true;
   }
 
@@ -317,8 +367,10 @@ class Flooring : public OperationInterface {
   Flooring() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::floor(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::floor(numbers[i]);
+    }
     return true;
   }
 
@@ -331,8 +383,10 @@ class Ceiling : public OperationInterface {
   Ceiling() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::ceil(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::ceil(numbers[i]);
+    }
     return true;
   }
 
@@ -345,8 +399,10 @@ class Rounding : public OperationInterface {
   Rounding() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::round(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::round(numbers[i]);
+    }
     return true;
   }
 
@@ -359,8 +415,11 @@ class RoundingUp : public OperationInterface {
   RoundingUp() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = (*number < 0.0) ? std::floor(*number) : std::ceil(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] =
+          (numbers[i] < 0.0) ? std::floor(numbers[i]) : std::ceil(numbers[i]);
+    }
     return true;
   }
 
@@ -373,8 +432,10 @@ class RoundingDown : public OperationInterface {
   RoundingDown() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::trunc(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::trunc(numbers[i]);
+    }
     return true;
   }
 
@@ -387,8 +448,10 @@ class UnitStep : public OperationInterface {
   UnitStep() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = (*number < 0.0) ? 0.0 : 1.0;
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = (numbers[i] < 0.0) ? 0.0 : 1.0;
+    }
     return true;
   }
 
@@ -401,8 +464,10 @@ class Sign : public OperationInterface {
   Sign() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = sptk::ExtractSign(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = sptk::ExtractSign(numbers[i]);
+    }
     return true;
   }
 
@@ -415,8 +480,10 @@ class Sine : public OperationInterface {
   Sine() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::sin(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::sin(numbers[i]);
+    }
     return true;
   }
 
@@ -429,8 +496,10 @@ class Cosine : public OperationInterface {
   Cosine() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::cos(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::cos(numbers[i]);
+    }
     return true;
   }
 
@@ -443,8 +512,10 @@ class Tangent : public OperationInterface {
   Tangent() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::tan(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::tan(numbers[i]);
+    }
     return true;
   }
 
@@ -457,8 +528,10 @@ class Arctangent : public OperationInterface {
   Arctangent() {
   }
 
-  virtual bool Run(double* number) const {
-    *number = std::atan(*number);
+  virtual bool Run(int num_data, double* numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      numbers[i] = std::atan(numbers[i]);
+    }
     return true;
   }
 
@@ -472,12 +545,15 @@ class MagicNumberRemover : public sptk::ScalarOperation::ModuleInterface {
       : magic_number_(magic_number) {
   }
 
-  virtual bool Run(double* number, bool* is_magic_number) const {
-    if (true == *is_magic_number) {
-      return false;
-    }
-    if (magic_number_ == *number) {
-      *is_magic_number = true;
+  virtual bool Run(int num_data, double* numbers,
+                   bool* is_magic_numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      if (true == is_magic_numbers[i]) {
+        return false;
+      }
+      if (magic_number_ == numbers[i]) {
+        is_magic_numbers[i] = true;
+      }
     }
     return true;
   }
@@ -493,10 +569,13 @@ class MagicNumberReplacer : public sptk::ScalarOperation::ModuleInterface {
       : replacement_number_(replacement_number) {
   }
 
-  virtual bool Run(double* number, bool* is_magic_number) const {
-    if (*is_magic_number) {
-      *number = replacement_number_;
-      *is_magic_number = false;
+  virtual bool Run(int num_data, double* numbers,
+                   bool* is_magic_numbers) const {
+    for (int i(0); i < num_data; ++i) {
+      if (is_magic_numbers[i]) {
+        numbers[i] = replacement_number_;
+        is_magic_numbers[i] = false;
+      }
     }
     return true;
   }
@@ -511,24 +590,31 @@ class MagicNumberReplacer : public sptk::ScalarOperation::ModuleInterface {
 namespace sptk {
 
 bool ScalarOperation::AddAdditionOperation(double addend) {
-  modules_.push_back(new OperationPerformer(new Addition(addend)));
+  if (modules_.empty() || !modules_.back()->MergeAddition(addend)) {
+    AffineTransformation* operation(new AffineTransformation());
+    operation->MergeAddition(addend);
+    modules_.push_back(new OperationPerformer(operation));
+  }
   return true;
 }
 
 bool ScalarOperation::AddSubtractionOperation(double subtrahend) {
-  modules_.push_back(new OperationPerformer(new Subtraction(subtrahend)));
-  return true;
+  // x - s is identical to x + (-s) in IEEE 754 arithmetic.
+  return AddAdditionOperation(-subtrahend);
 }
 
 bool ScalarOperation::AddMultiplicationOperation(double multiplier) {
-  modules_.push_back(new OperationPerformer(new Multiplication(multiplier)));
+  if (modules_.empty() || !modules_.back()->MergeMultiplication(multiplier)) {
+    AffineTransformation* operation(new AffineTransformation());
+    operation->MergeMultiplication(multiplier);
+    modules_.push_back(new OperationPerformer(operation));
+  }
   return true;
 }
 
 bool ScalarOperation::AddDivisionOperation(double divisor) {
   if (0.0 == divisor) return false;
-  modules_.push_back(new OperationPerformer(new Division(divisor)));
-  return true;
+  return AddMultiplicationOperation(1.0 / divisor);
 }
 
 bool ScalarOperation::AddModuloOperation(int divisor) {
@@ -663,15 +749,20 @@ bool ScalarOperation::AddMagicNumberReplacer(double replacement_number) {
 }
 
 bool ScalarOperation::Run(double* number, bool* is_magic_number) const {
-  if (NULL == number || NULL == is_magic_number) {
+  return Run(1, number, is_magic_number);
+}
+
+bool ScalarOperation::Run(int num_data, double* numbers,
+                          bool* is_magic_numbers) const {
+  if (num_data <= 0 || NULL == numbers || NULL == is_magic_numbers) {
     return false;
   }
 
-  *is_magic_number = false;
+  std::fill_n(is_magic_numbers, num_data, false);
   for (std::vector<ScalarOperation::ModuleInterface*>::const_iterator itr(
            modules_.begin());
        itr != modules_.end(); ++itr) {
-    if (!(*itr)->Run(number, is_magic_number)) {
+    if (!(*itr)->Run(num_data, numbers, is_magic_numbers)) {
       return false;
     }
   }
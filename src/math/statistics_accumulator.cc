@@ -44,10 +44,81 @@
 
 #include "SPTK/math/statistics_accumulator.h"
 
-#include <algorithm>   // std::copy, std::fill, std::transform
+#include <algorithm>   // std::copy, std::fill, std::min, std::transform
 #include <cmath>       // std::sqrt
 #include <cstddef>     // std::size_t
-#include <functional>  // std::bind1st, std::multiplies, std::plus, etc.
+#include <functional>  // std::bind1st, std::multiplies, std::ptr_fun
+
+namespace {
+
+// The number of vectors processed at once in the batch accumulation.
+const int kBlockSize(64);
+
+// The maximum number of data that can be held in a buffer.
+const double kMaxNumData(2147483647.0);
+
+// Add a value to a sum using Kahan's compensated summation.
+inline void AddWithCompensation(double value, double* sum,
+                                double* compensation) {
+  const double compensated_value(value - *compensation);
+  const double new_sum(*sum + compensated_value);
+  *compensation = (new_sum - *sum) - compensated_value;
+  *sum = new_sum;
+}
+
+double CalculateSum(const double* x, int length) {
+  double sum0(0.0), sum1(0.0), sum2(0.0), sum3(0.0);
+  int i(0);
+  for (; i + 4 <= length; i += 4) {
+    sum0 += x[i];
+    sum1 += x[i + 1];
+    sum2 += x[i + 2];
+    sum3 += x[i + 3];
+  }
+  for (; i < length; ++i) {
+    sum0 += x[i];
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+double CalculateInnerProduct(const double* x, const double* y, int length) {
+  double sum0(0.0), sum1(0.0), sum2(0.0), sum3(0.0);
+  int i(0);
+  for (; i + 4 <= length; i += 4) {
+    sum0 += x[i] * y[i];
+    sum1 += x[i + 1] * y[i + 1];
+    sum2 += x[i + 2] * y[i + 2];
+    sum3 += x[i + 3] * y[i + 3];
+  }
+  for (; i < length; ++i) {
+    sum0 += x[i] * y[i];
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+// Calculate the difference between the mean of the new data and that of the
+// accumulated data, and return the weight of its outer product in the update
+// of the second-order statistics (Chan et al., 1979).
+double CalculateDifferenceOfMean(int num_accumulated_data, int num_new_data,
+                                 int length, const double* accumulated_sum,
+                                 const double* new_sum, double* delta) {
+  if (0 == num_accumulated_data) {
+    std::fill(delta, delta + length, 0.0);
+    return 0.0;
+  }
+
+  const double inverse_num_accumulated_data(1.0 / num_accumulated_data);
+  const double inverse_num_new_data(1.0 / num_new_data);
+  for (int i(0); i < length; ++i) {
+    delta[i] = new_sum[i] * inverse_num_new_data -
+               accumulated_sum[i] * inverse_num_accumulated_data;
+  }
+
+  return static_cast<double>(num_accumulated_data) * num_new_data /
+         (static_cast<double>(num_accumulated_data) + num_new_data);
+}
+
+}  // namespace
 
 namespace sptk {
 
@@ -120,17 +191,10 @@ bool StatisticsAccumulator::GetDiagonalCovariance(
     diagonal_covariance->resize(num_order_ + 1);
   }
 
-  std::vector<double> mean;
-  if (!GetMean(buffer, &mean)) {
-    return false;
-  }
-
   const double inverse_num_data(1.0 / buffer.zeroth_order_statistics_);
-  const double* mu(&(mean[0]));
   double* variance(&((*diagonal_covariance)[0]));
   for (int i(0); i <= num_order_; ++i) {
-    variance[i] = inverse_num_data * buffer.second_order_statistics_[i][i] -
-                  mu[i] * mu[i];
+    variance[i] = inverse_num_data * buffer.second_order_statistics_[i][i];
   }
 
   return true;
@@ -166,18 +230,11 @@ bool StatisticsAccumulator::GetFullCovariance(
     full_covariance->Resize(num_order_ + 1);
   }
 
-  std::vector<double> mean;
-  if (!GetMean(buffer, &mean)) {
-    return false;
-  }
-
   const double inverse_num_data(1.0 / buffer.zeroth_order_statistics_);
-  const double* mu(&(mean[0]));
   for (int i(0); i <= num_order_; ++i) {
     for (int j(0); j <= i; ++j) {
       (*full_covariance)[i][j] =
-          inverse_num_data * buffer.second_order_statistics_[i][j] -
-          mu[i] * mu[j];
+          inverse_num_data * buffer.second_order_statistics_[i][j];
     }
   }
 
@@ -213,6 +270,76 @@ void StatisticsAccumulator::Clear(StatisticsAccumulator::Buffer* buffer) const {
   if (!is_valid_ || NULL != buffer) buffer->Clear();
 }
 
+bool StatisticsAccumulator::Merge(
+    const StatisticsAccumulator::Buffer& buffer_to_be_merged,
+    StatisticsAccumulator::Buffer* buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  if (!is_valid_ || NULL == buffer) {
+    return false;
+  }
+
+  const int num_data(buffer_to_be_merged.zeroth_order_statistics_);
+  if (0 == num_data) {
+    return true;
+  }
+  if (kMaxNumData <
+      static_cast<double>(buffer->zeroth_order_statistics_) + num_data) {
+    return false;
+  }
+
+  // prepare buffer
+  PrepareBuffer(buffer);
+  if (1 <= num_statistics_order_ &&
+      buffer->sum_of_block_.size() != static_cast<std::size_t>(length)) {
+    buffer->sum_of_block_.resize(length);
+  }
+
+  // Fold the compensation terms of the buffer to be merged.
+  double* sum(NULL);
+  if (1 <= num_statistics_order_) {
+    sum = &(buffer->sum_of_block_[0]);
+    for (int i(0); i < length; ++i) {
+      sum[i] = buffer_to_be_merged.first_order_statistics_[i] -
+               buffer_to_be_merged.compensation_for_first_order_statistics_[i];
+    }
+  }
+
+  // 2nd order
+  if (2 <= num_statistics_order_) {
+    const double* x(sum);
+    double* delta(&(buffer->delta_of_mean_[0]));
+    const double factor(CalculateDifferenceOfMean(
+        buffer->zeroth_order_statistics_, num_data, length,
+        &(buffer->first_order_statistics_[0]), x, delta));
+    for (int i(0); i < length; ++i) {
+      const double* m(&(buffer_to_be_merged.second_order_statistics_[i][0]));
+      const double* e(&(
+          buffer_to_be_merged.compensation_for_second_order_statistics_[i][0]));
+      double* s(&(buffer->second_order_statistics_[i][0]));
+      double* c(&(buffer->compensation_for_second_order_statistics_[i][0]));
+      for (int j(0); j <= i; ++j) {
+        AddWithCompensation((m[j] - e[j]) + factor * delta[i] * delta[j],
+                            &(s[j]), &(c[j]));
+      }
+    }
+  }
+
+  // 1st order
+  if (1 <= num_statistics_order_) {
+    double* s(&(buffer->first_order_statistics_[0]));
+    double* c(&(buffer->compensation_for_first_order_statistics_[0]));
+    for (int i(0); i < length; ++i) {
+      AddWithCompensation(sum[i], &(s[i]), &(c[i]));
+    }
+  }
+
+  // 0th order
+  buffer->zeroth_order_statistics_ += num_data;
+
+  return true;
+}
+
 bool StatisticsAccumulator::Run(const std::vector<double>& data,
                                 StatisticsAccumulator::Buffer* buffer) const {
   // check inputs
@@ -223,31 +350,166 @@ bool StatisticsAccumulator::Run(const std::vector<double>& data,
   }
 
   // prepare buffer
-  if (1 <= num_statistics_order_ &&
-      buffer->first_order_statistics_.size() !=
-          static_cast<std::size_t>(length)) {
-    buffer->first_order_statistics_.resize(length);
+  PrepareBuffer(buffer);
+
+  // 2nd order
+  const double* x(&(data[0]));
+  if (2 <= num_statistics_order_) {
+    double* delta(&(buffer->delta_of_mean_[0]));
+    const double factor(
+        CalculateDifferenceOfMean(buffer->zeroth_order_statistics_, 1, length,
+                                  &(buffer->first_order_statistics_[0]), x,
+                                  delta));
+    for (int i(0); i < length; ++i) {
+      double* s(&(buffer->second_order_statistics_[i][0]));
+      double* c(&(buffer->compensation_for_second_order_statistics_[i][0]));
+      for (int j(0); j <= i; ++j) {
+        AddWithCompensation(factor * delta[i] * delta[j], &(s[j]), &(c[j]));
+      }
+    }
   }
-  if (2 <= num_statistics_order_ &&
-      buffer->second_order_statistics_.GetNumDimension() != length) {
-    buffer->second_order_statistics_.Resize(length);
+
+  // 1st order
+  if (1 <= num_statistics_order_) {
+    double* s(&(buffer->first_order_statistics_[0]));
+    double* c(&(buffer->compensation_for_first_order_statistics_[0]));
+    for (int i(0); i < length; ++i) {
+      AddWithCompensation(x[i], &(s[i]), &(c[i]));
+    }
   }
 
   // 0th order
   ++(buffer->zeroth_order_statistics_);
 
-  // 1st order
+  return true;
+}
+
+bool StatisticsAccumulator::Run(const Matrix& data,
+                                StatisticsAccumulator::Buffer* buffer) const {
+  // check inputs
+  const int length(num_order_ + 1);
+  const int num_data(data.GetNumRow());
+  if (!is_valid_ || data.GetNumColumn() != length || num_data <= 0 ||
+      NULL == buffer) {
+    return false;
+  }
+
+  // prepare buffer
+  PrepareBuffer(buffer);
   if (1 <= num_statistics_order_) {
-    std::transform(
-        data.begin(), data.end(), buffer->first_order_statistics_.begin(),
-        buffer->first_order_statistics_.begin(), std::plus<double>());
+    if (buffer->transposed_block_.size() !=
+        static_cast<std::size_t>(kBlockSize * length)) {
+      buffer->transposed_block_.resize(kBlockSize * length);
+    }
+    if (buffer->sum_of_block_.size() != static_cast<std::size_t>(length)) {
+      buffer->sum_of_block_.resize(length);
+    }
+  }
+
+  if (num_statistics_order_ < 1) {
+    buffer->zeroth_order_statistics_ += num_data;
+    return true;
+  }
+
+  for (int begin(0); begin < num_data; begin += kBlockSize) {
+    const int block_size(std::min(kBlockSize, num_data - begin));
+
+    // Transpose the block so that each dimension is stored contiguously.
+    double* t(&(buffer->transposed_block_[0]));
+    for (int n(0); n < block_size; ++n) {
+      const double* x(data[begin + n]);
+      for (int i(0); i < length; ++i) {
+        t[i * block_size + n] = x[i];
+      }
+    }
+
+    double* sum(&(buffer->sum_of_block_[0]));
+    for (int i(0); i < length; ++i) {
+      sum[i] = CalculateSum(t + i * block_size, block_size);
+    }
+
+    // 2nd order
+    if (2 <= num_statistics_order_) {
+      // Center the block on its own mean.
+      for (int i(0); i < length; ++i) {
+        const double mean(sum[i] / block_size);
+        double* t_i(t + i * block_size);
+        for (int n(0); n < block_size; ++n) {
+          t_i[n] -= mean;
+        }
+      }
+
+      double* delta(&(buffer->delta_of_mean_[0]));
+      const double factor(CalculateDifferenceOfMean(
+          buffer->zeroth_order_statistics_, block_size, length,
+          &(buffer->first_order_statistics_[0]), sum, delta));
+      for (int i(0); i < length; ++i) {
+        const double* t_i(t + i * block_size);
+        double* s(&(buffer->second_order_statistics_[i][0]));
+        double* c(&(buffer->compensation_for_second_order_statistics_[i][0]));
+        for (int j(0); j <= i; ++j) {
+          AddWithCompensation(
+              CalculateInnerProduct(t_i, t + j * block_size, block_size) +
+                  factor * delta[i] * delta[j],
+              &(s[j]), &(c[j]));
+        }
+      }
+    }
+
+    // 1st order
+    {
+      double* s(&(buffer->first_order_statistics_[0]));
+      double* c(&(buffer->compensation_for_first_order_statistics_[0]));
+      for (int i(0); i < length; ++i) {
+        AddWithCompensation(sum[i], &(s[i]), &(c[i]));
+      }
+    }
+
+    // 0th order
+    buffer->zeroth_order_statistics_ += block_size;
+  }
+
+  return true;
+}
+
+bool StatisticsAccumulator::WriteStatistics(
+    const StatisticsAccumulator::Buffer& buffer,
+    std::ostream* output_stream) const {
+  if (!is_valid_ || NULL == output_stream) {
+    return false;
+  }
+
+  const int length(num_order_ + 1);
+  const int num_data(buffer.zeroth_order_statistics_);
+  if (!WriteStream(static_cast<double>(num_data), output_stream) ||
+      !WriteStream(static_cast<double>(length), output_stream)) {
+    return false;
+  }
+
+  if (1 <= num_statistics_order_) {
+    for (int i(0); i < length; ++i) {
+      const double sum(
+          0 == num_data
+              ? 0.0
+              : buffer.first_order_statistics_[i] -
+                    buffer.compensation_for_first_order_statistics_[i]);
+      if (!WriteStream(sum, output_stream)) {
+        return false;
+      }
+    }
   }
 
-  // 2nd order
   if (2 <= num_statistics_order_) {
     for (int i(0); i < length; ++i) {
       for (int j(0); j <= i; ++j) {
-        buffer->second_order_statistics_[i][j] += data[i] * data[j];
+        const double sum(
+            0 == num_data
+                ? 0.0
+                : buffer.second_order_statistics_[i][j] -
+                      buffer.compensation_for_second_order_statistics_[i][j]);
+        if (!WriteStream(sum, output_stream)) {
+          return false;
+        }
       }
     }
   }
@@ -255,4 +517,73 @@ bool StatisticsAccumulator::Run(const std::vector<double>& data,
   return true;
 }
 
+bool StatisticsAccumulator::ReadStatistics(
+    std::istream* input_stream, StatisticsAccumulator::Buffer* buffer,
+    bool* is_end_of_stream) const {
+  if (!is_valid_ || NULL == input_stream || NULL == buffer ||
+      NULL == is_end_of_stream) {
+    return false;
+  }
+
+  *is_end_of_stream =
+      (std::istream::traits_type::eof() == input_stream->peek());
+  if (*is_end_of_stream) {
+    return false;
+  }
+
+  double num_data, length_of_vector;
+  if (!ReadStream(&num_data, input_stream) || num_data < 0.0 ||
+      kMaxNumData < num_data ||
+      static_cast<double>(static_cast<int>(num_data)) != num_data) {
+    return false;
+  }
+  if (!ReadStream(&length_of_vector, input_stream) ||
+      static_cast<double>(num_order_ + 1) != length_of_vector) {
+    return false;
+  }
+
+  PrepareBuffer(buffer);
+  buffer->Clear();
+  buffer->zeroth_order_statistics_ = static_cast<int>(num_data);
+
+  const int length(num_order_ + 1);
+  if (1 <= num_statistics_order_) {
+    for (int i(0); i < length; ++i) {
+      if (!ReadStream(&(buffer->first_order_statistics_[i]), input_stream)) {
+        return false;
+      }
+    }
+  }
+
+  if (2 <= num_statistics_order_) {
+    for (int i(0); i < length; ++i) {
+      for (int j(0); j <= i; ++j) {
+        if (!ReadStream(&(buffer->second_order_statistics_[i][j]),
+                        input_stream)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+void StatisticsAccumulator::PrepareBuffer(
+    StatisticsAccumulator::Buffer* buffer) const {
+  const int length(num_order_ + 1);
+  if (1 <= num_statistics_order_ &&
+      buffer->first_order_statistics_.size() !=
+          static_cast<std::size_t>(length)) {
+    buffer->first_order_statistics_.resize(length);
+    buffer->compensation_for_first_order_statistics_.resize(length);
+  }
+  if (2 <= num_statistics_order_ &&
+      buffer->second_order_statistics_.GetNumDimension() != length) {
+    buffer->second_order_statistics_.Resize(length);
+    buffer->compensation_for_second_order_statistics_.Resize(length);
+    buffer->delta_of_mean_.resize(length);
+  }
+}
+
 }  // namespace sptk
@@ -48,6 +48,8 @@
 #include <stdexcept>  // std::out_of_range
 #include <string>     // std::string
 
+#include "SPTK/math/cholesky_decomposition.h"
+
 namespace {
 
 const std::string kErrorMessage("SymmetricMatrix: Out of range");
@@ -151,64 +153,10 @@ bool SymmetricMatrix::Invert(SymmetricMatrix* inverse_matrix) const {
     }
   }
 
-  if (inverse_matrix->num_dimension_ != num_dimension_) {
-    inverse_matrix->Resize(num_dimension_);
-  }
-
-  std::vector<double> diagonal_elements(num_dimension_);
-  SymmetricMatrix lower_triangular_matrix(num_dimension_);
-
-  diagonal_elements[0] = index_[0][0];
-  lower_triangular_matrix.index_[0][0] = 1.0;
-  for (int i(1); i < num_dimension_; ++i) {
-    for (int j(0); j < i; ++j) {
-      double tmp(index_[i][j]);
-      for (int k(0); k < j; ++k) {
-        tmp -= lower_triangular_matrix.index_[i][k] *
-               lower_triangular_matrix.index_[j][k] * diagonal_elements[k];
-      }
-      lower_triangular_matrix.index_[i][j] = tmp / diagonal_elements[j];
-    }
-
-    diagonal_elements[i] = index_[i][i];
-    for (int j(0); j < i; ++j) {
-      diagonal_elements[i] -= lower_triangular_matrix.index_[i][j] *
-                              lower_triangular_matrix.index_[i][j] *
-                              diagonal_elements[j];
-    }
-    lower_triangular_matrix.index_[i][i] = 1.0;
-  }
-
-  for (int i(num_dimension_ - 1); 0 <= i; --i) {
-    inverse_matrix->index_[i][i] = 1.0;
-    for (int j(i + 1); j < num_dimension_; ++j) {
-      inverse_matrix->index_[j][i] =
-          lower_triangular_matrix.index_[j][i] * inverse_matrix->index_[i][i];
-      for (int k(i + 1); k < j; ++k) {
-        inverse_matrix->index_[j][i] +=
-            lower_triangular_matrix.index_[j][k] * inverse_matrix->index_[k][i];
-      }
-      inverse_matrix->index_[j][i] *= -inverse_matrix->index_[j][j];
-    }
-  }
-
-  std::vector<double> inverse_diagonal_elements(num_dimension_);
-  for (int i(0); i < num_dimension_; ++i) {
-    inverse_diagonal_elements[i] = 1.0 / diagonal_elements[i];
-  }
-
-  for (int i(0); i < num_dimension_; ++i) {
-    for (int j(0); j <= i; ++j) {
-      double sum(0.0);
-      for (int k(i); k < num_dimension_; ++k) {
-        sum += inverse_matrix->index_[k][i] * inverse_diagonal_elements[k] *
-               inverse_matrix->index_[k][j];
-      }
-      inverse_matrix->index_[i][j] = sum;
-    }
-  }
-
-  return true;
+  CholeskyDecomposition cholesky_decomposition(num_dimension_ - 1);
+  CholeskyDecomposition::Buffer buffer;
+  return (cholesky_decomposition.Run(*this, &buffer) &&
+          cholesky_decomposition.Invert(buffer, inverse_matrix));
 }
 
 }  // namespace sptk
@@ -44,9 +44,11 @@
 
 #include "SPTK/quantizer/linde_buzo_gray_algorithm.h"
 
-#include <cfloat>   // DBL_MAX
-#include <cmath>    // std::fabs
-#include <cstddef>  // std::size_t
+#include <algorithm>  // std::min
+#include <cfloat>     // DBL_MAX
+#include <cmath>      // std::fabs
+#include <cstddef>    // std::size_t
+#include <thread>     // std::thread
 
 #include "SPTK/generator/normal_distributed_random_value_generation.h"
 
@@ -56,6 +58,17 @@ LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
     int num_order, int seed, int initial_codebook_size,
     int target_codebook_size, int minimum_num_vector_in_cluster,
     int num_iteration, double convergence_threshold, double splitting_factor)
+    : LindeBuzoGrayAlgorithm(num_order, seed, initial_codebook_size,
+                             target_codebook_size,
+                             minimum_num_vector_in_cluster, num_iteration,
+                             convergence_threshold, splitting_factor, 1) {
+}
+
+LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
+    int num_order, int seed, int initial_codebook_size,
+    int target_codebook_size, int minimum_num_vector_in_cluster,
+    int num_iteration, double convergence_threshold, double splitting_factor,
+    int num_thread)
     : num_order_(num_order),
       seed_(seed),
       initial_codebook_size_(initial_codebook_size),
@@ -64,6 +77,7 @@ LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
       num_iteration_(num_iteration),
       convergence_threshold_(convergence_threshold),
       splitting_factor_(splitting_factor),
+      num_thread_(num_thread),
       distance_calculator_(
           num_order_, DistanceCalculator::DistanceMetrics::kSquaredEuclidean),
       statistics_accumulator_(num_order_, 1),
@@ -73,8 +87,8 @@ LindeBuzoGrayAlgorithm::LindeBuzoGrayAlgorithm(
       target_codebook_size_ <= initial_codebook_size_ ||
       minimum_num_vector_in_cluster <= 0 || num_iteration_ <= 0 ||
       convergence_threshold < 0.0 || splitting_factor <= 0.0 ||
-      !distance_calculator_.IsValid() || !statistics_accumulator_.IsValid() ||
-      !vector_quantization_.IsValid()) {
+      num_thread_ <= 0 || !distance_calculator_.IsValid() ||
+      !statistics_accumulator_.IsValid() || !vector_quantization_.IsValid()) {
     is_valid_ = false;
   }
 }
@@ -99,6 +113,14 @@ bool LindeBuzoGrayAlgorithm::Run(
     codebook_index->resize(num_input_vector);
   }
   std::vector<StatisticsAccumulator::Buffer> buffers(target_codebook_size_);
+  VectorQuantization::Buffer buffer_for_vector_quantization;
+
+  // prepare memory for multithreading
+  const int num_thread(std::min(num_thread_, num_input_vector));
+  std::vector<StatisticsAccumulator::Buffer> buffers_for_other_threads(
+      (num_thread - 1) * target_codebook_size_);
+  std::vector<double> total_distances(num_thread);
+  std::vector<int> is_succeeded(num_thread);
 
   // prepare random value generator
   NormalDistributedRandomValueGeneration random_value_generation(seed_);
@@ -130,30 +152,70 @@ bool LindeBuzoGrayAlgorithm::Run(
     double prev_total_distance(DBL_MAX);
     for (int n(0); n < num_iteration_; ++n) {
       // initialize
-      double total_distance(0.0);
       for (int e(0); e < current_codebook_size; ++e) {
         statistics_accumulator_.Clear(&(buffers[e]));
       }
+      for (int t(1); t < num_thread; ++t) {
+        for (int e(0); e < current_codebook_size; ++e) {
+          statistics_accumulator_.Clear(
+              &(buffers_for_other_threads[(t - 1) * target_codebook_size_ +
+                                          e]));
+        }
+      }
 
       // accumulate statistics (E-step)
-      for (int i(0); i < num_input_vector; ++i) {
-        int index;
-        if (!vector_quantization_.Run(input_vectors[i], *codebook_vectors,
-                                      &index)) {
-          return false;
+      if (!vector_quantization_.SetCodebook(*codebook_vectors,
+                                            &buffer_for_vector_quantization)) {
+        return false;
+      }
+      // Each thread processes a contiguous chunk of input vectors and the
+      // partial statistics are merged in the order of chunks.
+      if (1 == num_thread) {
+        is_succeeded[0] = AccumulateStatistics(
+            input_vectors, *codebook_vectors, buffer_for_vector_quantization,
+            0, num_input_vector, codebook_index, &(buffers[0]),
+            &(total_distances[0]));
+      } else {
+        std::vector<std::thread> threads;
+        for (int t(0); t < num_thread; ++t) {
+          const int begin(static_cast<long long>(num_input_vector) * t /
+                          num_thread);
+          const int end(static_cast<long long>(num_input_vector) * (t + 1) /
+                        num_thread);
+          StatisticsAccumulator::Buffer* buffers_for_thread(
+              (0 == t) ? &(buffers[0])
+                       : &(buffers_for_other_threads[(t - 1) *
+                                                     target_codebook_size_]));
+          threads.push_back(std::thread([&, t, begin, end,
+                                         buffers_for_thread]() {
+            is_succeeded[t] = AccumulateStatistics(
+                input_vectors, *codebook_vectors,
+                buffer_for_vector_quantization, begin, end, codebook_index,
+                buffers_for_thread, &(total_distances[t]));
+          }));
         }
-        (*codebook_index)[i] = index;
-
-        if (!statistics_accumulator_.Run(input_vectors[i], &(buffers[index]))) {
-          return false;
+        for (std::vector<std::thread>::iterator itr(threads.begin());
+             itr != threads.end(); ++itr) {
+          itr->join();
         }
+      }
 
-        double distance;
-        if (!distance_calculator_.Run(input_vectors[i],
-                                      (*codebook_vectors)[index], &distance)) {
+      double total_distance(0.0);
+      for (int t(0); t < num_thread; ++t) {
+        if (!is_succeeded[t]) {
           return false;
         }
-        total_distance += distance;
+        total_distance += total_distances[t];
+        if (0 < t) {
+          for (int e(0); e < current_codebook_size; ++e) {
+            if (!statistics_accumulator_.Merge(
+                    buffers_for_other_threads[(t - 1) * target_codebook_size_ +
+                                              e],
+                    &(buffers[e]))) {
+              return false;
+            }
+          }
+        }
       }
       total_distance /= num_input_vector;
 
@@ -213,8 +275,13 @@ bool LindeBuzoGrayAlgorithm::Run(
   }
 
   // save final results
+  if (!vector_quantization_.SetCodebook(*codebook_vectors,
+                                        &buffer_for_vector_quantization)) {
+    return false;
+  }
   for (int i(0); i < num_input_vector; ++i) {
-    if (!vector_quantization_.Run(input_vectors[i], *codebook_vectors,
+    if (!vector_quantization_.Run(input_vectors[i],
+                                  buffer_for_vector_quantization,
                                   &((*codebook_index)[i]))) {
       return false;
     }
@@ -223,4 +290,34 @@ bool LindeBuzoGrayAlgorithm::Run(
   return true;
 }
 
+bool LindeBuzoGrayAlgorithm::AccumulateStatistics(
+    const std::vector<std::vector<double> >& input_vectors,
+    const std::vector<std::vector<double> >& codebook_vectors,
+    const VectorQuantization::Buffer& buffer_for_vector_quantization,
+    int begin, int end, std::vector<int>* codebook_index,
+    StatisticsAccumulator::Buffer* buffers, double* total_distance) const {
+  *total_distance = 0.0;
+  for (int i(begin); i < end; ++i) {
+    int index;
+    if (!vector_quantization_.Run(input_vectors[i],
+                                  buffer_for_vector_quantization, &index)) {
+      return false;
+    }
+    (*codebook_index)[i] = index;
+
+    if (!statistics_accumulator_.Run(input_vectors[i], &(buffers[index]))) {
+      return false;
+    }
+
+    double distance;
+    if (!distance_calculator_.Run(input_vectors[i], codebook_vectors[index],
+                                  &distance)) {
+      return false;
+    }
+    *total_distance += distance;
+  }
+
+  return true;
+}
+
 }  // namespace sptk
@@ -44,8 +44,78 @@
 
 #include "SPTK/quantizer/vector_quantization.h"
 
-#include <cfloat>   // DBL_MAX
-#include <cstddef>  // std::size_t
+#include <algorithm>  // std::copy
+#include <cfloat>     // DBL_MAX
+#include <cmath>      // std::fabs, std::sqrt
+#include <cstddef>    // std::size_t
+
+namespace {
+
+// Return a relative tolerance which covers rounding errors in the summation
+// of length non-negative terms regardless of the order of summation.
+double CalculateTolerance(int length) {
+  return 4.0 * (length + 1) * DBL_EPSILON;
+}
+
+// Calculate squared Euclidean distance in the same order as
+// DistanceCalculator.
+double CalculateDistance(const double* x, const double* y, int length) {
+  double sum(0.0);
+  for (int i(0); i < length; ++i) {
+    const double diff(x[i] - y[i]);
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+// Calculate squared Euclidean distance using independent partial sums. The
+// summation is stopped once the partial sum exceeds the threshold since the
+// distance cannot be smaller than the partial sum.
+double CalculateApproximateDistance(const double* x, const double* y,
+                                    int length, double threshold) {
+  double sum0(0.0), sum1(0.0), sum2(0.0), sum3(0.0);
+  int i(0);
+  for (int end(16); end <= length; end += 16) {
+    for (; i < end; i += 4) {
+      const double diff0(x[i] - y[i]);
+      const double diff1(x[i + 1] - y[i + 1]);
+      const double diff2(x[i + 2] - y[i + 2]);
+      const double diff3(x[i + 3] - y[i + 3]);
+      sum0 += diff0 * diff0;
+      sum1 += diff1 * diff1;
+      sum2 += diff2 * diff2;
+      sum3 += diff3 * diff3;
+    }
+    if (threshold < (sum0 + sum1) + (sum2 + sum3)) {
+      return (sum0 + sum1) + (sum2 + sum3);
+    }
+  }
+  for (; i + 4 <= length; i += 4) {
+    const double diff0(x[i] - y[i]);
+    const double diff1(x[i + 1] - y[i + 1]);
+    const double diff2(x[i + 2] - y[i + 2]);
+    const double diff3(x[i + 3] - y[i + 3]);
+    sum0 += diff0 * diff0;
+    sum1 += diff1 * diff1;
+    sum2 += diff2 * diff2;
+    sum3 += diff3 * diff3;
+  }
+  for (; i < length; ++i) {
+    const double diff(x[i] - y[i]);
+    sum0 += diff * diff;
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+double CalculateNorm(const double* x, int length) {
+  double sum(0.0);
+  for (int i(0); i < length; ++i) {
+    sum += x[i] * x[i];
+  }
+  return std::sqrt(sum);
+}
+
+}  // namespace
 
 namespace sptk {
 
@@ -69,16 +139,98 @@ bool VectorQuantization::Run(
     return false;
   }
 
+  const int length(num_order_ + 1);
   const int codebook_size(codebook_vectors.size());
+  const double tolerance(CalculateTolerance(length));
+  const double* x(&(input_vector[0]));
   int index(0);
   double minimum_distance(DBL_MAX);
 
   for (int i(0); i < codebook_size; ++i) {
-    double distance;
-    if (!distance_calculator_.Run(input_vector, codebook_vectors[i],
-                                  &distance)) {
+    if (codebook_vectors[i].size() != static_cast<std::size_t>(length)) {
       return false;
     }
+    const double* y(&(codebook_vectors[i][0]));
+
+    // Skip the codebook vector if it is certainly farther than the nearest
+    // one found so far. Otherwise, the distance is calculated exactly as in
+    // the exhaustive search so that the same index is always chosen.
+    const double threshold(minimum_distance * (1.0 + tolerance));
+    if (threshold < CalculateApproximateDistance(x, y, length, threshold)) {
+      continue;
+    }
+
+    const double distance(CalculateDistance(x, y, length));
+    if (distance < minimum_distance) {
+      index = i;
+      minimum_distance = distance;
+    }
+  }
+
+  *codebook_index = index;
+
+  return true;
+}
+
+bool VectorQuantization::SetCodebook(
+    const std::vector<std::vector<double> >& codebook_vectors,
+    VectorQuantization::Buffer* buffer) const {
+  if (!is_valid_ || codebook_vectors.empty() || NULL == buffer) {
+    return false;
+  }
+
+  const int length(num_order_ + 1);
+  const int codebook_size(codebook_vectors.size());
+
+  buffer->codebook_vectors_.resize(codebook_size * length);
+  buffer->norms_.resize(codebook_size);
+  for (int i(0); i < codebook_size; ++i) {
+    if (codebook_vectors[i].size() != static_cast<std::size_t>(length)) {
+      return false;
+    }
+    std::copy(codebook_vectors[i].begin(), codebook_vectors[i].end(),
+              buffer->codebook_vectors_.begin() + i * length);
+    buffer->norms_[i] = CalculateNorm(&(codebook_vectors[i][0]), length);
+  }
+
+  return true;
+}
+
+bool VectorQuantization::Run(const std::vector<double>& input_vector,
+                             const VectorQuantization::Buffer& buffer,
+                             int* codebook_index) const {
+  const int codebook_size(buffer.norms_.size());
+  if (!is_valid_ ||
+      input_vector.size() != static_cast<std::size_t>(num_order_ + 1) ||
+      0 == codebook_size || NULL == codebook_index) {
+    return false;
+  }
+
+  const int length(num_order_ + 1);
+  const double tolerance(CalculateTolerance(length));
+  const double* x(&(input_vector[0]));
+  const double* y(&(buffer.codebook_vectors_[0]));
+  const double* norms(&(buffer.norms_[0]));
+  const double norm(CalculateNorm(x, length));
+  int index(0);
+  double minimum_distance(DBL_MAX);
+
+  for (int i(0); i < codebook_size; ++i, y += length) {
+    // The difference between norms gives a lower bound of the distance by
+    // triangle inequality.
+    const double difference(std::fabs(norms[i] - norm) -
+                            tolerance * (norms[i] + norm));
+    if (0.0 < difference &&
+        minimum_distance < difference * difference * (1.0 - tolerance)) {
+      continue;
+    }
+
+    const double threshold(minimum_distance * (1.0 + tolerance));
+    if (threshold < CalculateApproximateDistance(x, y, length, threshold)) {
+      continue;
+    }
+
+    const double distance(CalculateDistance(x, y, length));
     if (distance < minimum_distance) {
       index = i;
       minimum_distance = distance;
@@ -0,0 +1,375 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+#include "SPTK/utils/parallel_frame_processing.h"
+
+#include <algorithm>           // std::copy, std::fill, std::max, std::min
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // std::size_t
+#include <mutex>               // std::lock_guard, std::mutex, std::unique_lock
+#include <thread>              // std::thread
+
+namespace {
+
+// The maximum number of frames processed by one thread at once.
+const int kMaxNumFrameInBlock(256);
+
+// The maximum number of elements of a frame block. Long frames are processed
+// in fewer frames at once so that a block stays in cache.
+const int kMaxNumElementInBlock(1 << 14);
+
+// A contiguous block of frames processed by one thread.
+struct Block {
+  // The frames are stored one per row.
+  sptk::Matrix input_frames;
+  // A copy of the leading frames of an incomplete block.
+  sptk::Matrix partial_input_frames;
+  sptk::Matrix output_frames;
+  // The number of frames in the block.
+  int num_frame;
+  // The number of leading frames processed successfully.
+  int num_processed_frame;
+};
+
+// A batch of frames. The t-th block is processed by the t-th thread.
+struct Batch {
+  std::vector<Block> blocks;
+  // The number of frames in the batch.
+  int num_frame;
+};
+
+// Threads that run a task for each worker every time they are started.
+class WorkerPool {
+ public:
+  WorkerPool(int num_worker, const std::function<void(int)>& task)
+      : task_(task),
+        generation_(0),
+        num_running_worker_(0),
+        is_stopped_(false) {
+    for (int t(0); t < num_worker; ++t) {
+      workers_.push_back(std::thread(&WorkerPool::Work, this, t));
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopped_ = true;
+    }
+    start_.notify_all();
+    for (std::vector<std::thread>::iterator itr(workers_.begin());
+         itr != workers_.end(); ++itr) {
+      itr->join();
+    }
+  }
+
+  // Let every worker run the task once.
+  void Start() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++generation_;
+      num_running_worker_ = static_cast<int>(workers_.size());
+    }
+    start_.notify_all();
+  }
+
+  // Wait until every worker has finished the task.
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_.wait(lock, [this] { return 0 == num_running_worker_; });
+  }
+
+ private:
+  void Work(int worker_index) {
+    int generation(0);
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock, [this, generation] {
+          return is_stopped_ || generation != generation_;
+        });
+        if (is_stopped_) {
+          return;
+        }
+        generation = generation_;
+      }
+      task_(worker_index);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (0 == --num_running_worker_) {
+          finish_.notify_one();
+        }
+      }
+    }
+  }
+
+  const std::function<void(int)> task_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finish_;
+  int generation_;
+  int num_running_worker_;
+  bool is_stopped_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerPool);
+};
+
+// Read up to the capacity of the batch. The last incomplete frame is filled
+// with zeros if zero_padding is true, otherwise it is discarded.
+void ReadBatch(int input_length, bool zero_padding, std::istream* input_stream,
+               Batch* batch) {
+  const std::streamsize frame_bytes(sizeof(double) * input_length);
+  batch->num_frame = 0;
+  for (std::vector<Block>::iterator itr(batch->blocks.begin());
+       itr != batch->blocks.end(); ++itr) {
+    itr->num_frame = 0;
+    itr->num_processed_frame = 0;
+  }
+
+  for (std::vector<Block>::iterator itr(batch->blocks.begin());
+       itr != batch->blocks.end(); ++itr) {
+    // the rows of a matrix are stored contiguously
+    const int capacity(itr->input_frames.GetNumRow());
+    double* input_frames(itr->input_frames[0]);
+    input_stream->read(reinterpret_cast<char*>(input_frames),
+                       frame_bytes * capacity);
+    const std::streamsize gcount(input_stream->gcount());
+
+    if (zero_padding) {
+      itr->num_frame = static_cast<int>((gcount + frame_bytes - 1) /
+                                        frame_bytes);
+      // an incomplete element is also regarded as zero
+      std::fill(input_frames + gcount / sizeof(double),
+                input_frames + itr->num_frame * input_length, 0.0);
+    } else {
+      itr->num_frame = static_cast<int>(gcount / frame_bytes);
+    }
+    batch->num_frame += itr->num_frame;
+
+    if (itr->num_frame < capacity) {
+      if (0 < itr->num_frame) {
+        itr->input_frames.GetSubmatrix(0, itr->num_frame, 0, input_length,
+                                       &itr->partial_input_frames);
+      }
+      break;
+    }
+  }
+}
+
+// Process the frames of the block assigned to the given thread.
+void ProcessBlock(
+    const std::function<int(const sptk::Matrix&, sptk::Matrix*, int)>&
+        block_task,
+    int thread_index, Block* block) {
+  if (0 == block->num_frame) {
+    block->num_processed_frame = 0;
+    return;
+  }
+  const sptk::Matrix& input_frames(
+      block->input_frames.GetNumRow() == block->num_frame
+          ? block->input_frames
+          : block->partial_input_frames);
+  block->num_processed_frame =
+      block_task(input_frames, &block->output_frames, thread_index);
+}
+
+}  // namespace
+
+namespace sptk {
+
+ParallelFrameProcessing::ParallelFrameProcessing(int input_length,
+                                                 int output_length,
+                                                 int num_thread,
+                                                 bool zero_padding)
+    : input_length_(input_length),
+      output_length_(output_length),
+      num_thread_(num_thread),
+      zero_padding_(zero_padding),
+      is_valid_(true) {
+  if (input_length_ <= 0 || output_length_ <= 0 || num_thread_ <= 0) {
+    is_valid_ = false;
+  }
+}
+
+bool ParallelFrameProcessing::Run(const FrameProcessor& frame_processor,
+                                  const FrameWriter& frame_writer,
+                                  std::istream* input_stream) const {
+  auto block_task = [this, &frame_processor](const Matrix& input_frames,
+                                             Matrix* output_frames,
+                                             int thread_index) {
+    const int num_frame(input_frames.GetNumRow());
+    if (output_frames->GetNumRow() != num_frame ||
+        output_frames->GetNumColumn() != output_length_) {
+      output_frames->Resize(num_frame, output_length_);
+    }
+    std::vector<double> input_frame(input_length_);
+    std::vector<double> output_frame(output_length_);
+    int num_processed_frame(0);
+    for (; num_processed_frame < num_frame; ++num_processed_frame) {
+      const double* input(input_frames[num_processed_frame]);
+      std::copy(input, input + input_length_, input_frame.begin());
+      if (!frame_processor(input_frame, &output_frame, thread_index) ||
+          output_frame.size() != static_cast<std::size_t>(output_length_)) {
+        break;
+      }
+      std::copy(output_frame.begin(), output_frame.end(),
+                (*output_frames)[num_processed_frame]);
+    }
+    return num_processed_frame;
+  };
+  return RunBlockTask(block_task, frame_writer, input_stream);
+}
+
+bool ParallelFrameProcessing::Run(const BlockProcessor& block_processor,
+                                  const FrameWriter& frame_writer,
+                                  std::istream* input_stream) const {
+  auto block_task = [this, &block_processor](const Matrix& input_frames,
+                                             Matrix* output_frames,
+                                             int thread_index) {
+    const int num_frame(input_frames.GetNumRow());
+    if (!block_processor(input_frames, output_frames, thread_index) ||
+        output_frames->GetNumRow() != num_frame ||
+        output_frames->GetNumColumn() != output_length_) {
+      return 0;
+    }
+    return num_frame;
+  };
+  return RunBlockTask(block_task, frame_writer, input_stream);
+}
+
+bool ParallelFrameProcessing::RunBlockTask(const BlockTask& block_task,
+                                           const FrameWriter& frame_writer,
+                                           std::istream* input_stream) const {
+  if (!is_valid_ || NULL == input_stream) {
+    return false;
+  }
+
+  // Two batches are used alternately: while the threads process one batch,
+  // the results of the previous batch are written and the next batch is read.
+  const int num_frame_in_block(std::max(
+      1, std::min(kMaxNumFrameInBlock,
+                  kMaxNumElementInBlock /
+                      std::max(input_length_, output_length_))));
+  Batch batches[2];
+  for (int i(0); i < 2; ++i) {
+    batches[i].blocks.resize(num_thread_);
+    for (int t(0); t < num_thread_; ++t) {
+      batches[i].blocks[t].input_frames.Resize(num_frame_in_block,
+                                               input_length_);
+      batches[i].blocks[t].num_frame = 0;
+      batches[i].blocks[t].num_processed_frame = 0;
+    }
+    batches[i].num_frame = 0;
+  }
+  std::vector<double> output_frame(output_length_);
+
+  // Write the frames of the batch in order. Return false when a frame has not
+  // been processed successfully.
+  auto write_batch = [&](const Batch& batch) {
+    for (std::vector<Block>::const_iterator itr(batch.blocks.begin());
+         itr != batch.blocks.end() && 0 < itr->num_frame; ++itr) {
+      for (int n(0); n < itr->num_processed_frame; ++n) {
+        const double* output(itr->output_frames[n]);
+        std::copy(output, output + output_length_, output_frame.begin());
+        if (!frame_writer(output_frame)) {
+          return false;
+        }
+      }
+      if (itr->num_processed_frame != itr->num_frame) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  int current(0);
+  ReadBatch(input_length_, zero_padding_, input_stream, &batches[current]);
+  if (1 == num_thread_) {
+    while (0 < batches[current].num_frame) {
+      ProcessBlock(block_task, 0, &batches[current].blocks[0]);
+      if (!write_batch(batches[current])) {
+        return false;
+      }
+      ReadBatch(input_length_, zero_padding_, input_stream, &batches[current]);
+    }
+    return true;
+  }
+
+  // The workers are kept alive across batches and started once per batch.
+  Batch* batch(NULL);
+  WorkerPool worker_pool(num_thread_, [&](int thread_index) {
+    ProcessBlock(block_task, thread_index, &batch->blocks[thread_index]);
+  });
+
+  bool has_previous_batch(false);
+  while (0 < batches[current].num_frame) {
+    batch = &batches[current];
+    worker_pool.Start();
+
+    bool is_succeeded(true);
+    if (has_previous_batch) {
+      is_succeeded = write_batch(batches[1 - current]);
+    }
+    if (is_succeeded) {
+      ReadBatch(input_length_, zero_padding_, input_stream,
+                &batches[1 - current]);
+    }
+
+    worker_pool.Wait();
+    if (!is_succeeded) {
+      return false;
+    }
+
+    has_previous_batch = true;
+    current = 1 - current;
+  }
+
+  if (has_previous_batch && !write_batch(batches[1 - current])) {
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace sptk
@@ -45,19 +45,37 @@
 #include "SPTK/utils/sptk_utils.h"
 
 #include <algorithm>  // std::fill_n, std::transform
-#include <cctype>     // std::tolower
+#include <cctype>     // std::isspace, std::tolower
 #include <cerrno>     // errno, ERANGE
 #include <cmath>      // std::ceil, std::exp, std::log, etc.
 #include <cstdint>    // int8_t, etc.
 #include <cstdio>     // std::snprintf
-#include <cstdlib>    // std::size_t, std::strtod, std::strtol
+#include <cstdlib>    // std::size_t, std::strtod, std::strtol, std::strtold
+#include <cstring>    // std::strlen
 #include <iomanip>    // std::setw
+#include <limits>     // std::numeric_limits
 
 #include "SPTK/utils/int24_t.h"
 #include "SPTK/utils/uint24_t.h"
 
 namespace {
 
+// Size of the buffer used by BufferedStreamReader and BufferedStreamWriter.
+static const std::size_t kBufferSizeForBufferedStream(1 << 16);
+
+// Powers of ten which are exactly representable in the 64-bit significand of
+// the x87 extended precision format, i.e., 5^n < 2^64.
+static const long double kExactPowersOfTen[] = {
+    1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+    1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+    1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L};
+
+// Maximum number of significant digits stored in uint64_t without overflow.
+static const int kMaxNumSignificantDigits(19);
+
+// Bound of the exponent part of a number parsed without std::strtold.
+static const int kMaxExplicitExponent(100000);
+
 // 34 is a reasonable number near log(1e-15)
 static const double kThresholdOfInformationLossInLogSpace(-34.0);
 
@@ -305,6 +323,94 @@ bool ConvertSpecialStringToDouble(const std::string& input, double* output) {
   return false;
 }
 
+bool ConvertLeadingStringToLongDouble(const std::string& input,
+                                      long double* output) {
+  if (input.empty() || NULL == output) {
+    return false;
+  }
+
+  // Try to parse a plain decimal number. If both its significand and its
+  // power of ten are exactly representable, a single multiplication or
+  // division gives the correctly rounded value, i.e., the value std::strtold
+  // returns (Clinger's fast path). Other strings are passed to std::strtold.
+  const int num_significand_bits(std::numeric_limits<long double>::digits);
+  const int max_exponent(64 <= num_significand_bits
+                             ? 27
+                             : 53 <= num_significand_bits ? 22 : -1);
+  const uint64_t max_significand(
+      64 <= num_significand_bits ? std::numeric_limits<uint64_t>::max()
+                                 : (static_cast<uint64_t>(1) << 53));
+
+  const char* p(input.c_str());
+  const bool is_negative('-' == *p);
+  if ('+' == *p || '-' == *p) ++p;
+
+  uint64_t significand(0);
+  int num_significant_digits(0);
+  int num_digits(0);
+  int exponent(0);
+  bool is_fast_path(0 <= max_exponent);
+  for (bool is_fraction(false); is_fast_path; ++p) {
+    if ('0' <= *p && *p <= '9') {
+      if (0 < significand || '0' != *p) {
+        if (kMaxNumSignificantDigits == num_significant_digits) {
+          is_fast_path = false;
+          break;
+        }
+        significand = 10 * significand + (*p - '0');
+        ++num_significant_digits;
+      }
+      if (is_fraction) --exponent;
+      ++num_digits;
+    } else if ('.' == *p && !is_fraction) {
+      is_fraction = true;
+    } else {
+      break;
+    }
+  }
+  if (is_fast_path && 0 < num_digits && ('e' == *p || 'E' == *p)) {
+    ++p;
+    const bool is_negative_exponent('-' == *p);
+    if ('+' == *p || '-' == *p) ++p;
+    int explicit_exponent(0);
+    int num_exponent_digits(0);
+    for (; '0' <= *p && *p <= '9'; ++p, ++num_exponent_digits) {
+      if (kMaxExplicitExponent < explicit_exponent) {
+        is_fast_path = false;
+      } else {
+        explicit_exponent = 10 * explicit_exponent + (*p - '0');
+      }
+    }
+    if (0 == num_exponent_digits) {
+      is_fast_path = false;
+    }
+    exponent += is_negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+
+  if (is_fast_path && 0 < num_digits && '\0' == *p &&
+      significand <= max_significand && -max_exponent <= exponent &&
+      exponent <= max_exponent) {
+    long double value(static_cast<long double>(significand));
+    if (0 <= exponent) {
+      value *= kExactPowersOfTen[exponent];
+    } else {
+      value /= kExactPowersOfTen[-exponent];
+    }
+    *output = is_negative ? -value : value;
+    return true;
+  }
+
+  errno = 0;
+  char* end;
+  const long double converted_value(std::strtold(input.c_str(), &end));
+  if (input.c_str() == end || ERANGE == errno) {
+    return false;
+  }
+
+  *output = converted_value;
+  return true;
+}
+
 bool IsInRange(int num, int min, int max) {
   return (min <= num && num <= max);
 }
@@ -534,6 +640,92 @@ void PrintErrorMessage(const std::string& program_name,
   std::cerr << stream.str();
 }
 
+BufferedStreamReader::BufferedStreamReader(std::istream* input_stream)
+    : input_stream_(input_stream),
+      buffer_(kBufferSizeForBufferedStream),
+      head_(0),
+      tail_(0) {
+}
+
+bool BufferedStreamReader::Fill(std::size_t num_bytes) {
+  if (NULL == input_stream_ || buffer_.size() < num_bytes) {
+    return false;
+  }
+
+  // Move the remaining bytes, e.g., a part of an element, to the front.
+  const std::size_t num_remaining_bytes(tail_ - head_);
+  if (0 < head_) {
+    std::copy(buffer_.begin() + head_, buffer_.begin() + tail_,
+              buffer_.begin());
+    head_ = 0;
+    tail_ = num_remaining_bytes;
+  }
+
+  while (tail_ < num_bytes && input_stream_->good()) {
+    input_stream_->read(&(buffer_[tail_]), buffer_.size() - tail_);
+    tail_ += input_stream_->gcount();
+  }
+
+  return num_bytes <= tail_;
+}
+
+bool BufferedStreamReader::ReadWord(std::string* word) {
+  if (NULL == word) {
+    return false;
+  }
+
+  word->clear();
+  while (head_ < tail_ || Fill(1)) {
+    if (word->empty()) {
+      while (head_ < tail_ &&
+             std::isspace(static_cast<unsigned char>(buffer_[head_]))) {
+        ++head_;
+      }
+    }
+    std::size_t end(head_);
+    while (end < tail_ &&
+           !std::isspace(static_cast<unsigned char>(buffer_[end]))) {
+      ++end;
+    }
+    word->append(buffer_.begin() + head_, buffer_.begin() + end);
+    head_ = end;
+    if (end < tail_) {
+      break;
+    }
+  }
+
+  return !word->empty();
+}
+
+BufferedStreamWriter::BufferedStreamWriter(std::ostream* output_stream)
+    : output_stream_(output_stream),
+      buffer_(kBufferSizeForBufferedStream),
+      size_(0) {
+}
+
+bool BufferedStreamWriter::WriteString(const char* string_to_write) {
+  if (NULL == string_to_write) {
+    return false;
+  }
+
+  const std::size_t length(std::strlen(string_to_write));
+  return 0 == length || Write(static_cast<int>(length), string_to_write);
+}
+
+bool BufferedStreamWriter::Flush() {
+  if (NULL == output_stream_) {
+    return false;
+  }
+
+  if (0 < size_) {
+    output_stream_->write(&(buffer_[0]), size_);
+    size_ = 0;
+  }
+  output_stream_->flush();
+
+  return !output_stream_->fail();
+}
+
 // clang-format off
 template bool ReadStream<int8_t>(int8_t*, std::istream*);
 template bool ReadStream<int16_t>(int16_t*, std::istream*);
@@ -0,0 +1,151 @@
+// ----------------------------------------------------------------- //
+//             The Speech Signal Processing Toolkit (SPTK)           //
+//             developed by SPTK Working Group                       //
+//             http://sp-tk.sourceforge.net/                         //
+// ----------------------------------------------------------------- //
+//                                                                   //
+//  Copyright (c) 1984-2007  Tokyo Institute of Technology           //
+//                           Interdisciplinary Graduate School of    //
+//                           Science and Engineering                 //
+//                                                                   //
+//                1996-2018  Nagoya Institute of Technology          //
+//                           Department of Computer Science          //
+//                                                                   //
+// All rights reserved.                                              //
+//                                                                   //
+// Redistribution and use in source and binary forms, with or        //
+// without modification, are permitted provided that the following   //
+// conditions are met:                                               //
+//                                                                   //
+// - Redistributions of source code must retain the above copyright  //
+//   notice, this list of conditions and the following disclaimer.   //
+// - Redistributions in binary form must reproduce the above         //
+//   copyright notice, this list of conditions and the following     //
+//   disclaimer in the documentation and/or other materials provided //
+//   with the distribution.                                          //
+// - Neither the name of the SPTK working group nor the names of its //
+//   contributors may be used to endorse or promote products derived //
+//   from this software without specific prior written permission.   //
+//                                                                   //
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND            //
+// CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,       //
+// INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF          //
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE          //
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS //
+// BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,          //
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED   //
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,     //
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON //
+// ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,   //
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY    //
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE           //
+// POSSIBILITY OF SUCH DAMAGE.                                       //
+// ----------------------------------------------------------------- //
+
+#include <algorithm>  // std::min
+#include <cstdint>    // int16_t
+#include <fstream>    // std::ifstream
+#include <iostream>   // std::cerr, std::cout, std::endl
+#include <vector>     // std::vector
+
+#include "SPTK/analyzer/pitch_extraction.h"
+#include "SPTK/analyzer/streaming_pitch_extraction.h"
+
+namespace {
+
+const char* kWaveformFile("data/SPTKexamples-data/data.short");
+const double kSamplingRate(16000.0);
+const double kVoicingThreshold(0.3);
+
+// Push the waveform in pieces of the given sizes, and check that the output
+// equals the offline output and that every frame is output within the
+// latency.
+bool Check(const std::vector<double>& waveform, int frame_shift,
+           double minimum_f0, double maximum_f0,
+           const std::vector<int>& piece_sizes) {
+  sptk::PitchExtraction pitch_extraction(frame_shift, kSamplingRate,
+                                         minimum_f0, maximum_f0,
+                                         kVoicingThreshold,
+                                         sptk::PitchExtraction::kSwipe);
+  sptk::StreamingPitchExtraction streaming_pitch_extraction(
+      frame_shift, kSamplingRate, minimum_f0, maximum_f0, kVoicingThreshold,
+      sptk::PitchExtraction::kSwipe);
+  std::vector<double> expected_f0;
+  if (!pitch_extraction.IsValid() || !streaming_pitch_extraction.IsValid() ||
+      !pitch_extraction.Run(waveform, &expected_f0, NULL, NULL)) {
+    std::cerr << "Failed to extract pitch" << std::endl;
+    return false;
+  }
+
+  // the buffer is used twice to check that Flush resets it
+  sptk::StreamingPitchExtraction::Buffer buffer;
+  const int latency(streaming_pitch_extraction.GetLatency());
+  for (int pass(0); pass < 2; ++pass) {
+    std::vector<double> actual_f0;
+    std::vector<double> piece;
+    std::vector<double> f0;
+    const int waveform_length(waveform.size());
+    for (int i(0), j(0); i < waveform_length; ++j) {
+      const int end(std::min(
+          waveform_length, i + piece_sizes[j % piece_sizes.size()]));
+      piece.assign(waveform.begin() + i, waveform.begin() + end);
+      i = end;
+      if (!streaming_pitch_extraction.Push(piece, &buffer) ||
+          !streaming_pitch_extraction.Pull(&f0, &buffer)) {
+        std::cerr << "Failed to stream pitch" << std::endl;
+        return false;
+      }
+      actual_f0.insert(actual_f0.end(), f0.begin(), f0.end());
+      const int num_final_frame(i < latency ? 0
+                                            : (i - latency) / frame_shift + 1);
+      if (static_cast<int>(actual_f0.size()) < num_final_frame) {
+        std::cerr << "Frame " << actual_f0.size() << " is not output within "
+                  << latency << " samples" << std::endl;
+        return false;
+      }
+    }
+    if (!streaming_pitch_extraction.Flush(&f0, &buffer)) {
+      std::cerr << "Failed to flush pitch" << std::endl;
+      return false;
+    }
+    actual_f0.insert(actual_f0.end(), f0.begin(), f0.end());
+
+    // the streaming output must converge exactly to the offline output
+    if (actual_f0 != expected_f0) {
+      std::cerr << "Streaming f0 differs from offline f0 (frame shift "
+                << frame_shift << ", f0 range " << minimum_f0 << "-"
+                << maximum_f0 << ")" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::ifstream ifs(kWaveformFile, std::ios::in | std::ios::binary);
+  if (ifs.fail()) {
+    std::cerr << "Cannot open file " << kWaveformFile << std::endl;
+    return 1;
+  }
+  std::vector<double> waveform;
+  int16_t sample;
+  while (ifs.read(reinterpret_cast<char*>(&sample), sizeof(sample))) {
+    waveform.push_back(sample);
+  }
+
+  // odd piece sizes unrelated to the frame shift and the window lengths
+  const std::vector<int> small_pieces{1, 37, 160, 5, 1001, 2, 333};
+  const std::vector<int> large_pieces{4097, 12345};
+  if (!Check(waveform, 80, 60.0, 240.0, small_pieces) ||
+      !Check(waveform, 80, 60.0, 240.0, large_pieces) ||
+      !Check(waveform, 160, 80.0, 400.0, small_pieces) ||
+      !Check(waveform, 1, 100.0, 300.0, large_pieces)) {
+    return 1;
+  }
+
+  std::cout << "streaming_pitch_extraction_test: OK" << std::endl;
+  return 0;
+}
@@ -131,8 +131,10 @@ void La(matrix L, vector f, vector fERBs,
         return;
     double* fo0 = &(((*fo)[0])[0]);
     double* fo1 = &(((*fo)[1])[0]);
-    vector a = makev(w2);
-    for (j = 0; j < w2; j++) // this iterates over only the first half
+    // the Nyquist bin is included so that splinv() does not read beyond the
+    // end at the highest ERB frequencies
+    vector a = makev(w2 + 1);
+    for (j = 0; j <= w2; j++) // this iterates over only the first half
         a.v[j] = sqrt(fo0[j] * fo0[j] + fo1[j] * fo1[j]);
 #endif
     vector a2 = spline(f, a); // a2 is now the result of the cubic spline
@@ -164,8 +166,13 @@ matrix loudness(vector x, vector fERBs, double nyquist, int w, int w2) {
     vector hann = makev(w); // this defines the Hann[ing] window
     for (i = 0; i < w; i++) 
         hann.v[i] = .5 - (.5 * cos(2. * M_PI * ((double) i / w)));
+#if 0
     vector f = makev(w2);
     for (i = 0; i < w2; i++) 
+#else
+    vector f = makev(w2 + 1);
+    for (i = 0; i <= w2; i++) 
+#endif
         f.v[i] = i * td;
     hi = bisectv(f, fERBs.v[0]); // all calls to La() will begin here
     matrix L = makem(ceil((double) x.x / w2) + 1, fERBs.x); 
@@ -221,6 +228,37 @@ matrix loudness(vector x, vector fERBs, double nyquist, int w, int w2) {
     return(L);
 }
 
+// computes the normalized kernel of a pitch candidate
+vector kernel(vector fERBs, double pci, intvector ps) {
+    int j, k;
+    double td;
+    vector q = makev(fERBs.x);
+    for (j = 0; j < q.x; j++) q.v[j] = fERBs.v[j] / pci;
+    vector kernel = zerov(fERBs.x); // a zero-filled kernel vector
+    for (j = 0; j < ps.x; j++) {
+        if PRIME(ps.v[j]) {
+            for (k = 0; k < kernel.x; k++) {
+                td = fabs(q.v[k] - j - 1.); 
+                if (td < .25) // peaks
+                    kernel.v[k] = cos(2. * M_PI * q.v[k]);
+                else if (td < .75)  // valleys
+                    kernel.v[k] += cos(2. * M_PI * q.v[k]) / 2.;
+            }
+        }
+    }
+    freev(q);
+    td = 0.; 
+    for (j = 0; j < kernel.x; j++) {
+        kernel.v[j] *= sqrt(1. / fERBs.v[j]); // applying the envelope
+        if (kernel.v[j] > 0.) 
+            td += kernel.v[j] * kernel.v[j];
+    }
+    td = sqrt(td); // now, td is the p=2 norm factor
+    for (j = 0; j < kernel.x; j++) // normalize the kernel
+        kernel.v[j] /= td;
+    return(kernel);
+}
+
 // populates the strength matrix using the loudness matrix
 void Sadd(matrix S, matrix L, vector fERBs, vector pci, vector mu, 
                                             intvector ps, double dt, 
@@ -233,6 +271,7 @@ void Sadd(matrix S, matrix L, vector fERBs, vector pci, vector mu,
     double dtp = w2 / nyquist2;
     matrix Slocal = zerom(psz, L.x);
     for (i = 0; i < Slocal.x; i++) {
+#if 0
         vector q = makev(fERBs.x);
         for (j = 0; j < q.x; j++) q.v[j] = fERBs.v[j] / pci.v[i];
         vector kernel = zerov(fERBs.x); // a zero-filled kernel vector
@@ -257,6 +296,9 @@ void Sadd(matrix S, matrix L, vector fERBs, vector pci, vector mu,
         td = sqrt(td); // now, td is the p=2 norm factor
         for (j = 0; j < kernel.x; j++) // normalize the kernel
             kernel.v[j] /= td;
+#else
+        vector kernel = swipe::kernel(fERBs, pci.v[i], ps);
+#endif
         for (j = 0; j < L.x; j++) { 
             for (k = 0; k < L.y; k++) 
                 Slocal.m[i][j] += kernel.v[k] * L.m[j][k]; // i.e, kernel' * L
@@ -408,6 +450,34 @@ vector pitch(matrix S, vector pc, double st) {
     return(p);
 }
 
+// computes the window sizes, the pitch candidates, the ERB frequencies, and
+// the harmonics used by swipe()
+void setup(double nyquist, double nyquist16, double min, double max,
+           intvector* ws, vector* pc, vector* d, vector* fERBs,
+           intvector* ps) {
+    int i;
+    double td = 0.;
+    *ws = makeiv(round(log2((nyquist16) / min) -  
+                       log2((nyquist16) / max)) + 1); 
+    for (i = 0; i < ws->x; i++)
+        ws->v[i] = pow(2, round(log2(nyquist16 / min))) / pow(2, i);
+    *pc = makev(ceil((log2(max) - log2(min)) / DLOG2P));
+    *d = makev(pc->x);
+    for (i = pc->x - 1; i >= 0; i--) { 
+        td = log2(min) + (i * DLOG2P);
+        pc->v[i] = pow(2, td);
+        d->v[i] = 1. + td - log2(nyquist16 / ws->v[0]); 
+    } // td now equals log2(min)
+    *fERBs = makev(ceil((hz2erb(nyquist) - 
+                         hz2erb(pow(2, td) / 4)) / DERBS));
+    td = hz2erb(min / 4.);
+    for (i = 0; i < fERBs->x; i++) 
+        fERBs->v[i] = erb2hz(td + (i * DERBS));
+    *ps = onesiv(floor(fERBs->v[fERBs->x - 1] / pc->v[0] - .75));
+    sieve(*ps);
+    ps->v[0] = PR; // hack to make 1 "act" prime...don't ask
+}
+
 // primary utility function for each pitch extraction
 #if 0
 vector swipe(int fid, double min, double max, double st, double dt) {
@@ -416,7 +486,9 @@ vector swipe(const std::vector<double>& waveform, double samplerate, double min,
              double max, double st, double dt) {
 #endif
     int i; 
+#if 0
     double td = 0.;
+#endif
 #if 0
     SF_INFO info;
     SNDFILE* source = sf_open_fd(fid, SFM_READ, &info, true);
@@ -439,6 +511,7 @@ vector swipe(const std::vector<double>& waveform, double samplerate, double min,
         dt = nyquist2;
         fprintf(stderr, "Timestep > SR...timestep set to %f.\n", nyquist2);
     }
+#if 0
     intvector ws = makeiv(round(log2((nyquist16) / min) -  
                                 log2((nyquist16) / max)) + 1); 
     for (i = 0; i < ws.x; i++)
@@ -469,6 +542,16 @@ vector swipe(const std::vector<double>& waveform, double samplerate, double min,
     intvector ps = onesiv(floor(fERBs.v[fERBs.x - 1] / pc.v[0] - .75));
     sieve(ps);
     ps.v[0] = PR; // hack to make 1 "act" prime...don't ask
+#else
+    intvector ws, ps;
+    vector pc, d, fERBs;
+    setup(nyquist, nyquist16, min, max, &ws, &pc, &d, &fERBs, &ps);
+    double n = 1. / 32768.;
+    int frames = waveform.size();
+    vector x = makev(frames);
+    for (i = 0; i < frames; i++)
+        x.v[i] = waveform[i] * n;
+#endif
     matrix S = zerom(pc.x, ceil(((double) x.x / nyquist2) / dt));
     Sfirst(S, x, pc, fERBs, d, ws, ps, nyquist, nyquist2, dt, 0); 
     for (i = 1; i < ws.x - 1; i++) // S is updated inline here
@@ -486,6 +569,209 @@ vector swipe(const std::vector<double>& waveform, double samplerate, double min,
     return(p);
 }
 
+StreamingSwipe::StreamingSwipe(double samplerate, double min, double max,
+                               double st, double dt) {
+    int i, j, n;
+    double nyquist = samplerate / 2.;
+    double nyquist16 = samplerate * 8.;
+    nyquist2 = samplerate;
+    this->st = st;
+    this->dt = dt;
+    intvector ws, ps;
+    vector d;
+    setup(nyquist, nyquist16, min, max, &ws, &pc, &d, &fERBs, &ps);
+    windows.resize(ws.x);
+    for (n = 0; n < ws.x; n++) { // the same candidates as Sfirst/Snth/Slast
+        Window& window = windows[n];
+        window.w = ws.v[n];
+        window.w2 = ws.v[n] / 2;
+        window.dtp = window.w2 / nyquist2;
+        window.f = makev(window.w2 + 1);
+        for (i = 0; i <= window.w2; i++) 
+            window.f.v[i] = i * (nyquist / window.w2);
+        window.hann = makev(window.w);
+        for (i = 0; i < window.w; i++) 
+            window.hann.v[i] = .5 - (.5 * cos(2. * M_PI * 
+                                              ((double) i / window.w)));
+        window.hi = bisectv(window.f, fERBs.v[0]);
+        window.plan = new sptk::FastFourierTransformForRealSequence(
+            window.w - 1, window.w);
+        window.lo = (n == 0) ? 0 : bisectv(d, n);
+        int hi = (n == 0) ? bisectv(d, 2.) : 
+                 (n == ws.x - 1) ? d.x : bisectv(d, n + 2);
+        window.mu = makev(hi - window.lo);
+        window.kernels = makem(hi - window.lo, fERBs.x);
+        for (i = 0; i < window.mu.x; i++) {
+            window.mu.v[i] = 1. - fabs(d.v[window.lo + i] - (n + 1));
+            vector kernel = swipe::kernel(fERBs, pc.v[window.lo + i], ps);
+            for (j = 0; j < kernel.x; j++) 
+                window.kernels.m[i][j] = kernel.v[j];
+            freev(kernel);
+        }
+    }
+    freeiv(ws);
+    freeiv(ps);
+    freev(d);
+}
+
+StreamingSwipe::~StreamingSwipe() {
+    for (size_t n = 0; n < windows.size(); n++) {
+        freev(windows[n].f);
+        freev(windows[n].hann);
+        freev(windows[n].mu);
+        freem(windows[n].kernels);
+        delete windows[n].plan;
+    }
+    freev(pc);
+    freev(fERBs);
+}
+
+int StreamingSwipe::GetLatency() const {
+    return(windows.empty() ? 0 : windows[0].w);
+}
+
+void StreamingSwipe::Push(const std::vector<double>& waveform, 
+                          StreamingSwipeBuffer* buffer) const {
+    double n = 1. / 32768.;
+    for (size_t i = 0; i < waveform.size(); i++)
+        buffer->x.push_back(waveform[i] * n);
+    buffer->num_samples += waveform.size();
+}
+
+// computes the strength of the candidates at a window position as Sadd() does
+void StreamingSwipe::Column(const Window& window, int i, 
+                            StreamingSwipeBuffer* buffer, 
+                            std::vector<double>* column) const {
+    int j, k;
+    int offset = (i - 1) * window.w2; // zero outside of the signal
+    for (j = 0; j < window.w; j++) {
+        k = offset + j;
+        buffer->fi[j] = (k < 0 || k >= buffer->num_samples) ? 0. : 
+            buffer->x[k - buffer->first_sample] * window.hann.v[j];
+    }
+    matrix L = makem(1, fERBs.x);
+    La(L, window.f, fERBs, *window.plan, buffer->fi, &buffer->fo, 
+       &buffer->buffer, window.w2, window.hi, 0);
+    double td = 0.;
+    for (j = 0; j < L.y; j++) 
+        td += L.m[0][j] * L.m[0][j];
+    if (td != 0.) { 
+        td = sqrt(td);
+        for (j = 0; j < L.y; j++) 
+            L.m[0][j] /= td;
+    }
+    column->assign(window.mu.x, 0.);
+    for (j = 0; j < window.mu.x; j++) {
+        for (k = 0; k < L.y; k++) 
+            (*column)[j] += window.kernels.m[j][k] * L.m[0][k];
+    }
+    freem(L);
+}
+
+void StreamingSwipe::Pull(bool flush, std::vector<double>* p, 
+                          StreamingSwipeBuffer* buffer) const {
+    int i, j, n;
+    int num_windows = windows.size();
+    p->clear();
+    if (buffer->columns.empty()) {
+        buffer->columns.resize(num_windows);
+        buffer->first_column.assign(num_windows, 0);
+        buffer->tp.assign(num_windows, 0.);
+        buffer->k.assign(num_windows, 0);
+    }
+    // compute the window positions whose samples are all pushed
+    for (n = 0; n < num_windows; n++) {
+        const Window& window = windows[n];
+        int end = flush ? 
+            (int) ceil((double) buffer->num_samples / window.w2) + 1 : 
+            buffer->num_samples / window.w2;
+        buffer->fi.resize(window.w);
+        buffer->fo.resize(2, std::vector<double>(window.w));
+        for (i = buffer->first_column[n] + buffer->columns[n].size(); 
+             i < end; i++) {
+            buffer->columns[n].push_back(std::vector<double>());
+            Column(window, i, buffer, &buffer->columns[n].back());
+        }
+    }
+    // output the frames whose window positions are all computed
+    int num_frames = ceil(((double) buffer->num_samples / nyquist2) / dt);
+    std::vector<double> tp(num_windows);
+    std::vector<int> k(num_windows);
+    std::vector<double> td(num_windows);
+    for (/* j = buffer->num_frames */; buffer->num_frames < num_frames; 
+         buffer->num_frames++) {
+        for (n = 0; n < num_windows; n++) {
+            tp[n] = buffer->tp[n];
+            k[n] = buffer->k[n];
+            td[n] = buffer->t - tp[n];
+            while (td[n] >= 0.) {
+                k[n]++;
+                tp[n] += windows[n].dtp;
+                td[n] -= windows[n].dtp;
+            }
+            if (k[n] >= buffer->first_column[n] + 
+                       (int) buffer->columns[n].size()) 
+                break;
+        }
+        if (n < num_windows) 
+            break;
+        matrix S = zerom(pc.x, 1);
+        for (n = 0; n < num_windows; n++) {
+            const Window& window = windows[n];
+            const std::vector<double>& c0 = 
+                buffer->columns[n][k[n] - 1 - buffer->first_column[n]];
+            const std::vector<double>& c1 = 
+                buffer->columns[n][k[n] - buffer->first_column[n]];
+            for (i = 0; i < window.mu.x; i++) {
+                S.m[window.lo + i][0] += (c1[i] + (td[n] * (c1[i] - 
+                                          c0[i])) / window.dtp) * 
+                                         window.mu.v[i];
+            }
+            buffer->tp[n] = tp[n];
+            buffer->k[n] = k[n];
+        }
+        vector pj = pitch(S, pc, st);
+        p->push_back(pj.v[0]);
+        freev(pj);
+        freem(S);
+        buffer->t += dt;
+    }
+    if (flush) {
+        buffer->x.clear();
+        buffer->first_sample = 0;
+        buffer->num_samples = 0;
+        buffer->num_frames = 0;
+        buffer->t = 0.;
+        buffer->columns.clear();
+        return;
+    }
+    // discard the window positions and the samples no longer used
+    int first_sample = buffer->num_samples;
+    for (n = 0; n < num_windows; n++) {
+        while (buffer->first_column[n] < buffer->k[n] - 1) {
+            buffer->columns[n].pop_front();
+            buffer->first_column[n]++;
+        }
+        j = (buffer->first_column[n] + buffer->columns[n].size() - 1) * 
+            windows[n].w2;
+        if (j < first_sample) 
+            first_sample = j < 0 ? 0 : j;
+    }
+    if (buffer->first_sample < first_sample) {
+        buffer->x.erase(buffer->x.begin(), 
+                        buffer->x.begin() + 
+                        (first_sample - buffer->first_sample));
+        buffer->first_sample = first_sample;
+    }
+}
+
+StreamingSwipeBuffer::StreamingSwipeBuffer()
+    : first_sample(0), num_samples(0), num_frames(0), t(0.) {
+}
+
+StreamingSwipeBuffer::~StreamingSwipeBuffer() {
+}
+
 #if 0
 // a Python version of the call
 vector pyswipe(char wav[], double min, double max, double st, double dt) {
@@ -33,8 +33,11 @@ vector pyswipe(char[], double, double, double, double);
 #ifndef SWIPE_H
 #define SWIPE_H
 
+#include <deque>
 #include <vector>
 #include "vector.h"
+#include "SPTK/math/fast_fourier_transform_for_real_sequence.h"
+#include "SPTK/utils/sptk_utils.h"
 
 namespace sptk {
 namespace swipe {
@@ -42,6 +45,80 @@ namespace swipe {
 vector swipe(const std::vector<double>&, double, double, double, double,
              double);
 
+class StreamingSwipeBuffer;
+
+// SWIPE' applied to a waveform given piece by piece. The loudness of each
+// window position is computed once, as soon as the samples it covers are
+// pushed, and the pitch of a frame is output as soon as the loudness it is
+// interpolated from is available. The output is identical to that of swipe().
+class StreamingSwipe {
+ public:
+  StreamingSwipe(double, double, double, double, double);
+  ~StreamingSwipe();
+
+  // the number of samples to be pushed after the first sample of a frame
+  // before the pitch of the frame is output
+  int GetLatency() const;
+
+  void Push(const std::vector<double>&, StreamingSwipeBuffer*) const;
+
+  // if flush is true, the waveform is regarded as ended and the buffer is
+  // cleared for the next waveform
+  void Pull(bool, std::vector<double>*, StreamingSwipeBuffer*) const;
+
+ private:
+  struct Window {
+    int w;
+    int w2;
+    int lo;
+    int hi;
+    double dtp;
+    vector f;
+    vector hann;
+    vector mu;
+    matrix kernels;
+    sptk::FastFourierTransformForRealSequence* plan;
+  };
+
+  void Column(const Window&, int, StreamingSwipeBuffer*,
+              std::vector<double>*) const;
+
+  double nyquist2;
+  double st;
+  double dt;
+  vector pc;
+  vector fERBs;
+  std::vector<Window> windows;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingSwipe);
+};
+
+class StreamingSwipeBuffer {
+ public:
+  StreamingSwipeBuffer();
+  ~StreamingSwipeBuffer();
+
+ private:
+  // the scaled waveform from the sample first_sample
+  std::vector<double> x;
+  int first_sample;
+  int num_samples;
+  int num_frames;
+  double t;
+  // for each window size, the strength of the pitch candidates at the window
+  // positions from first_column, and the interpolation state of Sadd()
+  std::vector<std::deque<std::vector<double> > > columns;
+  std::vector<int> first_column;
+  std::vector<double> tp;
+  std::vector<int> k;
+  std::vector<double> fi;
+  std::vector<std::vector<double> > fo;
+  sptk::FastFourierTransformForRealSequence::Buffer buffer;
+  friend class StreamingSwipe;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingSwipeBuffer);
+};
+
 }  // namespace swipe
 }  // namespace sptk
 #endif
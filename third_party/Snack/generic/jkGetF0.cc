@@ -26,7 +26,6 @@
 #if 1
 #include <algorithm>  /* std::max, std::min */
 #include <cfloat>     /* FLT_MAX */
-#include "SPTK/generator/normal_distributed_random_value_generation.h"
 #endif
 #ifndef TRUE
 # define TRUE 1
@@ -608,6 +607,12 @@ static void do_ffir(float *buf, int in_samps, float *bufo, int *out_samps,
   register float *sp;
   register float *buf1;
 
+  /* The memory may have been released by free_dp_f0(). */
+  if (NULL == mem2) {
+    mem = NULL;
+    fsize = 0;
+  }
+
   buf1 = buf;
   if(ncoef > fsize) {/*allocate memory for full coeff. array and filter memory */    fsize = 0;
     i = (ncoef+1)*2;
@@ -1818,7 +1823,7 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
   long sound_length = waveform.size();
   float *tmp = (float *)ckalloc(sizeof(float) * (5 + sound_length / frame_shift));
   float *buf;
-  double fsp, noise, noise_sdev = 50.0;
+  double fsp;
   int alpha, beta, pad_length, total_length;
 #endif
   int count = 0;
@@ -1844,15 +1849,12 @@ cGet_f0(const std::vector<double> &waveform, int frame_shift,
   total_length = sound_length + pad_length;
   buf = (float *)ckalloc(sizeof(float) * total_length);
 
-  /* Add noise to robustly estimate F0 values. */
-  sptk::NormalDistributedRandomValueGeneration generator(1);
+  /* The waveform has been dithered by the caller. */
   for (i = 0; i < sound_length; i++) {
-    if (!generator.Get(&noise)) return 1;
-    buf[i] = waveform[i] + noise * noise_sdev;
+    buf[i] = waveform[i];
   }
   for (i = sound_length; i < total_length; i++) {
-    if (!generator.Get(&noise)) return 1;
-    buf[i] = noise * noise_sdev;
+    buf[i] = 0.0f;
   }
 #endif
 